@@ -0,0 +1,97 @@
+#include <assert.h>
+#include <js.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+static const int iterations = 1000000;
+
+template <bool checked>
+constexpr js_function_options_t options = [] {
+  js_function_options_t options;
+  options.checked = checked;
+  return options;
+}();
+
+template <typename T>
+void
+on_call(T) {}
+
+template <bool checked, typename T>
+static double
+bench(js_env_t *env, T value) {
+  int e;
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_function_t<void, T> fn;
+  e = js_create_function<on_call<T>, options<checked>>(env, fn);
+  assert(e == 0);
+
+  uint64_t start = uv_hrtime();
+
+  for (int i = 0; i < iterations; i++) {
+    js_handle_scope_t *scope;
+    e = js_open_handle_scope(env, &scope);
+    assert(e == 0);
+
+    e = js_call_function(env, fn, value);
+    assert(e == 0);
+
+    e = js_close_handle_scope(env, scope);
+    assert(e == 0);
+  }
+
+  uint64_t elapsed = uv_hrtime() - start;
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  return double(elapsed) / iterations;
+}
+
+template <typename T>
+static void
+bench(js_env_t *env, const char *label, T value) {
+  double unchecked = bench<false>(env, value);
+  double checked = bench<true>(env, value);
+
+  printf("%-10s unchecked %7.2f ns/call, checked %7.2f ns/call, overhead %6.2f ns/argument\n", label, unchecked, checked, checked - unchecked);
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  bench(env, "bool", true);
+  bench(env, "int32", int32_t(-42));
+  bench(env, "uint32", uint32_t(42));
+  bench(env, "int64", int64_t(-42));
+  bench(env, "uint64", uint64_t(42));
+  bench(env, "double", 42.5);
+  bench(env, "bigint64", js_bigint64_t(-42));
+  bench(env, "biguint64", js_biguint64_t(42));
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,112 @@
+#include <assert.h>
+#include <js.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <utility>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+static const int iterations = 1000;
+
+static const size_t functions = 128;
+
+template <size_t i>
+int32_t
+on_call(js_env_t *env) {
+  return int32_t(i);
+}
+
+template <size_t i>
+constexpr js_string_literal_t<5> name = [] {
+  js_string_literal_t name("f000");
+  name.value[1] = char('0' + i / 100 % 10);
+  name.value[2] = char('0' + i / 10 % 10);
+  name.value[3] = char('0' + i % 10);
+  return name;
+}();
+
+template <size_t... i>
+static auto
+exports(std::index_sequence<i...>) -> js_exports_t<js_export_t<name<i>, on_call<i>>...>;
+
+using exports_t = decltype(exports(std::make_index_sequence<functions>()));
+
+template <size_t... i>
+static int
+define_per_property(js_env_t *env, const js_object_t &object, std::index_sequence<i...>) {
+  int err = 0;
+
+  (((err = js_set_property<on_call<i>>(env, object, name<i>.data())) == 0) && ...);
+
+  return err;
+}
+
+template <typename F>
+static double
+bench(js_env_t *env, F &&define) {
+  int e;
+
+  uint64_t start = uv_hrtime();
+
+  for (int i = 0; i < iterations; i++) {
+    js_handle_scope_t *scope;
+    e = js_open_handle_scope(env, &scope);
+    assert(e == 0);
+
+    js_object_t exports;
+    e = js_create_object(env, exports);
+    assert(e == 0);
+
+    e = define(exports);
+    assert(e == 0);
+
+    e = js_close_handle_scope(env, scope);
+    assert(e == 0);
+  }
+
+  uint64_t elapsed = uv_hrtime() - start;
+
+  return double(elapsed) / iterations / 1000;
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  double per_property = bench(env, [=](const js_object_t &exports) {
+    return define_per_property(env, exports, std::make_index_sequence<functions>());
+  });
+
+  double batched = bench(env, [=](const js_object_t &exports) {
+    return exports_t::define(env, exports);
+  });
+
+  double lazy = bench(env, [=](const js_object_t &exports) {
+    return exports_t::define_lazy(env, exports);
+  });
+
+  printf("%zu functions\n", functions);
+  printf("per-property %8.2f us/module\n", per_property);
+  printf("batched      %8.2f us/module\n", batched);
+  printf("lazy         %8.2f us/module\n", lazy);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
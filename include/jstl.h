@@ -1,18 +1,57 @@
 #pragma once
 
+#if defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#endif
+
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <coroutine>
+#include <iterator>
+#include <map>
 #include <memory>
+#include <mutex>
 #include <optional>
+#include <ranges>
 #include <span>
 #include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
 #include <utility>
+#include <variant>
 #include <vector>
 
+#include <assert.h>
+#include <errno.h>
 #include <js.h>
+#include <limits.h>
 #include <math.h>
 #include <stdbool.h>
 #include <stdint.h>
+#include <stdlib.h>
 #include <utf.h>
+#include <uv.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#if defined(_WIN32)
+#pragma push_macro("min")
+#pragma push_macro("max")
+#undef min
+#undef max
+#endif
 
 #ifndef NDEBUG
 constexpr bool js_is_debug = true;
@@ -41,6 +80,25 @@ concept js_typedarray_element =
 
 struct js_typedarray_element_any;
 
+template <size_t N>
+struct js_string_literal_t {
+  constexpr js_string_literal_t(const char (&value)[N]) {
+    std::copy_n(value, N, this->value);
+  }
+
+  constexpr const char *
+  data() const {
+    return value;
+  }
+
+  constexpr size_t
+  length() const {
+    return N - 1;
+  }
+
+  char value[N];
+};
+
 struct js_handle_t {
   js_handle_t() : value_(nullptr) {}
 
@@ -274,704 +332,672 @@ private:
   js_ref_t *ref_;
 };
 
-template <int check(js_env_t *, js_value_t *, bool *result)>
-static inline int
-js_check_value(js_env_t *env, js_value_t *value, const char *label) {
-  int err;
+template <typename T>
+struct js_weak_t {
+  js_weak_t() : env_(nullptr), ref_(nullptr) {}
 
-  bool is_type;
-  err = check(env, value, &is_type);
-  if (err < 0) return err;
+  js_weak_t(js_env_t *env, js_ref_t *ref) : env_(env), ref_(ref) {};
 
-  if (is_type) return 0;
+  js_weak_t(js_weak_t &&that) : env_(that.env_), ref_(that.ref_) {
+    that.ref_ = nullptr;
+  }
 
-  err = js_throw_type_errorf(env, nullptr, "Value is not of type '%s'", label);
-  assert(err == 0);
+  js_weak_t(const js_weak_t &) = delete;
 
-  return js_pending_exception;
-}
+  ~js_weak_t() {
+    reset();
+  }
 
-template <int check(js_env_t *, const js_handle_t &, bool &result)>
-static inline int
-js_check_value(js_env_t *env, js_value_t *value, const char *label) {
-  int err;
+  void
+  operator=(js_weak_t &&that) {
+    reset();
 
-  bool is_type;
-  err = check(env, js_handle_t(value), is_type);
-  if (err < 0) return err;
+    env_ = that.env_;
+    ref_ = that.ref_;
 
-  if (is_type) return 0;
+    that.ref_ = nullptr;
+  }
 
-  err = js_throw_type_errorf(env, nullptr, "Value is not of type '%s'", label);
-  assert(err == 0);
+  void
+  operator=(const js_weak_t &) = delete;
 
-  return js_pending_exception;
-}
+  explicit operator bool() const {
+    return ref_ != nullptr;
+  }
 
-template <typename T>
-struct js_typedarray_info_t;
+  explicit operator js_ref_t *() const {
+    return ref_;
+  }
 
-template <>
-struct js_typedarray_info_t<int8_t> {
-  static constexpr auto type = js_int8array;
+  void
+  reset() {
+    if (ref_ == nullptr) return;
 
-  static constexpr auto label = "int8array";
+    int err;
+    err = js_delete_reference(env_, ref_);
+    assert(err == 0);
 
-  static auto
-  is(js_env_t *env, const js_handle_t &value, bool &result) {
-    return js_is_int8array(env, static_cast<js_value_t *>(value), &result);
+    ref_ = nullptr;
+  }
+
+  bool
+  empty() const {
+    return ref_ == nullptr;
   }
+
+private:
+  js_env_t *env_;
+  js_ref_t *ref_;
 };
 
-template <>
-struct js_typedarray_info_t<uint8_t> {
-  static constexpr auto type = js_uint8array;
+template <typename K, typename T, typename Hash = std::hash<K>>
+struct js_weak_cache_t {
+  js_weak_cache_t() : threshold_(64) {}
 
-  static constexpr auto label = "uint8array";
+  js_weak_cache_t(const js_weak_cache_t &) = delete;
 
-  static auto
-  is(js_env_t *env, const js_handle_t &value, bool &result) {
-    return js_is_uint8array(env, static_cast<js_value_t *>(value), &result);
-  }
-};
+  void
+  operator=(const js_weak_cache_t &) = delete;
 
-template <>
-struct js_typedarray_info_t<int16_t> {
-  static constexpr auto type = js_int16array;
+  int
+  get(js_env_t *env, const K &key, std::optional<T> &result) {
+    int err;
 
-  static constexpr auto label = "int16array";
+    result.reset();
 
-  static auto
-  is(js_env_t *env, const js_handle_t &value, bool &result) {
-    return js_is_int16array(env, static_cast<js_value_t *>(value), &result);
-  }
-};
+    auto it = entries_.find(key);
 
-template <>
-struct js_typedarray_info_t<uint16_t> {
-  static constexpr auto type = js_uint16array;
+    if (it == entries_.end()) return 0;
 
-  static constexpr auto label = "uint16array";
+    js_value_t *value;
+    err = js_get_reference_value(env, static_cast<js_ref_t *>(it->second), &value);
+    if (err < 0) return err;
 
-  static auto
-  is(js_env_t *env, const js_handle_t &value, bool &result) {
-    return js_is_uint16array(env, static_cast<js_value_t *>(value), &result);
+    if (value) result = T(value);
+    else entries_.erase(it);
+
+    return 0;
   }
-};
 
-template <>
-struct js_typedarray_info_t<int32_t> {
-  static constexpr auto type = js_int32array;
+  int
+  set(js_env_t *env, const K &key, const T &value) {
+    int err;
 
-  static constexpr auto label = "int32array";
+    js_ref_t *ref;
+    err = js_create_reference(env, static_cast<js_value_t *>(value), 0, &ref);
+    if (err < 0) return err;
 
-  static auto
-  is(js_env_t *env, const js_handle_t &value, bool &result) {
-    return js_is_int32array(env, static_cast<js_value_t *>(value), &result);
-  }
-};
+    if (entries_.size() >= threshold_) sweep(env);
 
-template <>
-struct js_typedarray_info_t<uint32_t> {
-  static constexpr auto type = js_uint32array;
+    entries_.insert_or_assign(key, js_weak_t<T>(env, ref));
 
-  static constexpr auto label = "uint32array";
+    return 0;
+  }
 
-  static auto
-  is(js_env_t *env, const js_handle_t &value, bool &result) {
-    return js_is_uint32array(env, static_cast<js_value_t *>(value), &result);
+  void
+  erase(const K &key) {
+    entries_.erase(key);
   }
-};
 
-template <>
-struct js_typedarray_info_t<int64_t> {
-  static constexpr auto type = js_bigint64array;
+  void
+  clear() {
+    entries_.clear();
 
-  static constexpr auto label = "bigint64array";
+    threshold_ = 64;
+  }
 
-  static auto
-  is(js_env_t *env, const js_handle_t &value, bool &result) {
-    return js_is_bigint64array(env, static_cast<js_value_t *>(value), &result);
+  size_t
+  size() const {
+    return entries_.size();
   }
-};
 
-template <>
-struct js_typedarray_info_t<uint64_t> {
-  static constexpr auto type = js_biguint64array;
+private:
+  void
+  sweep(js_env_t *env) {
+    int err;
 
-  static constexpr auto label = "biguint64array";
+    for (auto it = entries_.begin(); it != entries_.end();) {
+      js_value_t *value;
+      err = js_get_reference_value(env, static_cast<js_ref_t *>(it->second), &value);
+      assert(err == 0);
 
-  static auto
-  is(js_env_t *env, const js_handle_t &value, bool &result) {
-    return js_is_biguint64array(env, static_cast<js_value_t *>(value), &result);
+      if (value) it++;
+      else it = entries_.erase(it);
+    }
+
+    threshold_ = std::max<size_t>(64, entries_.size() * 2);
   }
+
+  std::unordered_map<K, js_weak_t<T>, Hash> entries_;
+  size_t threshold_;
 };
 
-template <>
-struct js_typedarray_info_t<float> {
-  static constexpr auto type = js_float32array;
+template <js_string_literal_t... names>
+struct js_object_shape_t {
+  static_assert(sizeof...(names) > 0, "Shape must have at least one property");
 
-  static constexpr auto label = "float32array";
+  static constexpr size_t length = sizeof...(names);
 
-  static auto
-  is(js_env_t *env, const js_handle_t &value, bool &result) {
-    return js_is_float32array(env, static_cast<js_value_t *>(value), &result);
-  }
-};
+  js_object_shape_t() {}
 
-template <>
-struct js_typedarray_info_t<double> {
-  static constexpr auto type = js_float64array;
+  js_object_shape_t(std::array<js_persistent_t<js_string_t>, length> keys) : keys_(std::move(keys)) {}
 
-  static constexpr auto label = "float64array";
+  const std::array<js_persistent_t<js_string_t>, length> &
+  keys() const {
+    return keys_;
+  }
 
-  static auto
-  is(js_env_t *env, const js_handle_t &value, bool &result) {
-    return js_is_float64array(env, static_cast<js_value_t *>(value), &result);
+  void
+  reset() {
+    for (auto &key : keys_) key.reset();
   }
+
+  bool
+  empty() const {
+    return keys_[0].empty();
+  }
+
+private:
+  std::array<js_persistent_t<js_string_t>, length> keys_;
 };
 
-template <>
-struct js_typedarray_info_t<js_typedarray_element_any> {
-  static constexpr auto label = "typedarray";
+struct js_env_storage_t {
+  struct slot_t {
+    void *data = nullptr;
+    void (*destroy)(void *data) = nullptr;
+  };
 
-  static auto
-  is(js_env_t *env, const js_handle_t &value, bool &result) {
-    return js_is_typedarray(env, static_cast<js_value_t *>(value), &result);
+  static size_t
+  allocate() {
+    return next_.fetch_add(1, std::memory_order_relaxed);
   }
-};
 
-template <typename T = js_typedarray_element_any>
-static inline auto
-js_is_typedarray(js_env_t *env, const js_handle_t &value, bool &result) {
-  return js_typedarray_info_t<T>::is(env, value, result);
-}
+  static js_env_storage_t &
+  get(js_env_t *env) {
+    if (env == env_) return *storage_;
 
-struct js_type_options_t {
-  bool checked = js_is_debug;
+    auto it = envs_.find(env);
 
-  constexpr js_type_options_t() = default;
+    js_env_storage_t *storage;
 
-  constexpr js_type_options_t(const js_type_options_t &that) : checked(that.checked) {}
-};
+    if (it == envs_.end()) {
+      storage = new js_env_storage_t(env);
 
-template <typename T>
-struct js_type_info_t;
+      int err;
+      err = js_add_teardown_callback(env, on_teardown, storage);
+      assert(err == 0);
 
-template <>
-struct js_type_info_t<void> {
-  using type = void;
+      envs_.emplace(env, storage);
+    } else {
+      storage = it->second;
+    }
 
-  static constexpr auto signature = js_undefined;
+    env_ = env;
+    storage_ = storage;
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *env, js_value_t *&result) {
-    return js_get_undefined(env, &result);
+    return *storage;
   }
-};
 
-template <>
-struct js_type_info_t<bool> {
-  using type = bool;
+  static js_env_storage_t *
+  find(js_env_t *env) {
+    if (env == env_) return storage_;
 
-  static constexpr auto signature = js_boolean;
+    auto it = envs_.find(env);
 
-  static auto
-  marshall(bool value, bool &result) {
-    result = value;
+    if (it == envs_.end()) return nullptr;
 
-    return 0;
+    return it->second;
   }
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *, bool value, bool &result) {
-    return marshall(value, result);
-  }
+  slot_t &
+  slot(size_t index) {
+    if (index >= slots_.size()) slots_.resize(index + 1);
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *env, bool value, js_value_t *&result) {
-    return js_get_boolean(env, value, &result);
+    return slots_[index];
   }
 
-  static auto
-  unmarshall(bool value, bool &result) {
-    result = value;
+private:
+  js_env_storage_t(js_env_t *env) : owner_(env) {}
 
-    return 0;
-  }
+  static void
+  on_teardown(void *data) {
+    auto storage = reinterpret_cast<js_env_storage_t *>(data);
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *, bool value, bool &result) {
-    return unmarshall(value, result);
-  }
+    while (!storage->slots_.empty()) {
+      auto slot = storage->slots_.back();
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, bool &result) {
-    if constexpr (options.checked) {
-      int err;
-      err = js_check_value<js_is_boolean>(env, value, "boolean");
-      if (err < 0) return err;
+      storage->slots_.pop_back();
+
+      if (slot.data) slot.destroy(slot.data);
     }
 
-    return js_get_value_bool(env, value, &result);
+    envs_.erase(storage->owner_);
+
+    if (storage_ == storage) {
+      env_ = nullptr;
+      storage_ = nullptr;
+    }
+
+    delete storage;
   }
-};
 
-constexpr int64_t js_min_safe_integer = -9007199254740991;
+  js_env_t *owner_;
+  std::vector<slot_t> slots_;
 
-constexpr int64_t js_max_safe_integer = 9007199254740991;
+  static inline std::atomic<size_t> next_ = 0;
 
-static inline auto
-js_is_int64(js_env_t *env, const js_handle_t &value, bool &result) {
-  int err;
-  err = js_is_number(env, static_cast<js_value_t *>(value), &result);
-  if (err < 0) return err;
+  static inline thread_local js_env_t *env_ = nullptr;
+  static inline thread_local js_env_storage_t *storage_ = nullptr;
+  static inline thread_local std::unordered_map<js_env_t *, js_env_storage_t *> envs_;
+};
 
-  if (result == false) return 0;
+template <typename T>
+struct js_env_local_t {
+  js_env_local_t() : index_(js_env_storage_t::allocate()) {}
 
-  double n, i;
-  err = js_get_value_double(env, static_cast<js_value_t *>(value), &n);
-  if (err < 0) return err;
+  js_env_local_t(const js_env_local_t &) = delete;
 
-  result = modf(n, &i) == 0.0 && i >= js_min_safe_integer && i <= js_max_safe_integer;
+  void
+  operator=(const js_env_local_t &) = delete;
 
-  return 0;
-}
+  T &
+  get(js_env_t *env) const {
+    auto &storage = js_env_storage_t::get(env);
 
-static inline auto
-js_is_uint64(js_env_t *env, const js_handle_t &value, bool &result) {
-  int err;
-  err = js_is_number(env, static_cast<js_value_t *>(value), &result);
-  if (err < 0) return err;
+    auto data = storage.slot(index_).data;
 
-  if (result == false) return 0;
+    if (data) return *reinterpret_cast<T *>(data);
 
-  double n, i;
-  err = js_get_value_double(env, static_cast<js_value_t *>(value), &n);
-  if (err < 0) return err;
+    T *value;
 
-  result = modf(n, &i) == 0.0 && i >= 0.0 && i <= js_max_safe_integer;
+    if constexpr (std::is_constructible_v<T, js_env_t *>) {
+      value = new T(env);
+    } else {
+      value = new T();
+    }
 
-  return 0;
-}
+    storage.slot(index_) = {value, [](void *data) { delete reinterpret_cast<T *>(data); }};
 
-template <>
-struct js_type_info_t<int32_t> {
-  using type = int32_t;
+    return *value;
+  }
 
-  static constexpr auto signature = js_int32;
+  T *
+  find(js_env_t *env) const {
+    auto storage = js_env_storage_t::find(env);
 
-  static auto
-  marshall(int32_t value, int32_t &result) {
-    result = value;
+    if (storage == nullptr) return nullptr;
 
-    return 0;
+    return reinterpret_cast<T *>(storage->slot(index_).data);
   }
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *, int32_t value, int32_t &result) {
-    return marshall(value, result);
-  }
+private:
+  size_t index_;
+};
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *env, int32_t value, js_value_t *&result) {
-    return js_create_int32(env, value, &result);
-  }
+template <js_string_literal_t name>
+struct js_property_key_t {
+  static int
+  get(js_env_t *env, js_value_t *&result) {
+    int err;
 
-  static auto
-  unmarshall(int32_t value, int32_t &result) {
-    result = value;
+    auto &key = key_.get(env);
 
-    return 0;
-  }
+    if (key) return js_get_reference_value(env, static_cast<js_ref_t *>(key), &result);
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *, int32_t value, int32_t &result) {
-    return unmarshall(value, result);
-  }
+    err = js_create_property_key_utf8(env, reinterpret_cast<const utf8_t *>(name.data()), name.length(), &result);
+    if (err < 0) return err;
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, int32_t &result) {
-    if constexpr (options.checked) {
-      int err;
-      err = js_check_value<js_is_int32>(env, value, "int32");
-      if (err < 0) return err;
-    }
+    js_ref_t *ref;
+    err = js_create_reference(env, result, 1, &ref);
+    if (err < 0) return err;
 
-    return js_get_value_int32(env, value, &result);
+    key = js_persistent_t<js_string_t>(env, ref);
+
+    return 0;
   }
+
+private:
+  static inline js_env_local_t<js_persistent_t<js_string_t>> key_;
 };
 
-template <>
-struct js_type_info_t<uint32_t> {
-  using type = uint32_t;
+template <typename T>
+constexpr bool js_preserve_identity = false;
 
-  static constexpr auto signature = js_uint32;
+struct js_external_cache_t {
+  static int
+  get(js_env_t *env, void *data, js_value_t *&result) {
+    int err;
 
-  static auto
-  marshall(uint32_t value, uint32_t &result) {
-    result = value;
+    auto &cache = cache_.get(env);
 
-    return 0;
-  }
+    std::optional<js_handle_t> external;
+    err = cache.get(env, data, external);
+    if (err < 0) return err;
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *, uint32_t value, uint32_t &result) {
-    return marshall(value, result);
-  }
+    if (external) {
+      result = static_cast<js_value_t *>(*external);
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *env, uint32_t value, js_value_t *&result) {
-    return js_create_uint32(env, value, &result);
-  }
+      return 0;
+    }
 
-  static auto
-  unmarshall(uint32_t value, uint32_t &result) {
-    result = value;
+    err = js_create_external(env, data, nullptr, nullptr, &result);
+    if (err < 0) return err;
 
-    return 0;
+    return cache.set(env, data, js_handle_t(result));
   }
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *, uint32_t value, uint32_t &result) {
-    return unmarshall(value, result);
+private:
+  static inline js_env_local_t<js_weak_cache_t<void *, js_handle_t>> cache_;
+};
+
+struct js_scope_t {
+  js_scope_t(js_env_t *env) : env_(env) {
+    int err;
+    err = js_open_handle_scope(env_, &scope_);
+    assert(err == 0);
   }
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, uint32_t &result) {
-    if constexpr (options.checked) {
-      int err;
-      err = js_check_value<js_is_uint32>(env, value, "uint32");
-      if (err < 0) return err;
-    }
+  js_scope_t(const js_scope_t &) = delete;
 
-    return js_get_value_uint32(env, value, &result);
+  ~js_scope_t() {
+    close();
   }
-};
 
-template <>
-struct js_type_info_t<int64_t> {
-  using type = int64_t;
+  void
+  operator=(const js_scope_t &) = delete;
 
-  static constexpr auto signature = js_int64;
+  void
+  close() {
+    if (scope_ == nullptr) return;
 
-  static auto
-  marshall(int64_t value, int64_t &result) {
-    result = value;
+    int err;
+    err = js_close_handle_scope(env_, scope_);
+    assert(err == 0);
 
-    return 0;
+    scope_ = nullptr;
   }
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *, int64_t value, int64_t &result) {
-    return marshall(value, result);
-  }
+private:
+  js_env_t *env_;
+  js_handle_scope_t *scope_;
+};
 
-  template <js_type_options_t options>
-  static int
-  marshall(js_env_t *env, int64_t value, js_value_t *&result) {
-    if (options.checked) {
-      int err;
+struct js_escapable_scope_t {
+  js_escapable_scope_t(js_env_t *env) : env_(env) {
+    int err;
+    err = js_open_escapable_handle_scope(env_, &scope_);
+    assert(err == 0);
+  }
 
-      if (value < js_min_safe_integer) {
-        err = js_throw_range_errorf(env, nullptr, "Value '%lld' is less than Number.MIN_SAFE_INTEGER", value);
-        assert(err == 0);
+  js_escapable_scope_t(const js_escapable_scope_t &) = delete;
 
-        return js_pending_exception;
-      }
+  ~js_escapable_scope_t() {
+    close();
+  }
 
-      if (value > js_max_safe_integer) {
-        err = js_throw_range_errorf(env, nullptr, "Value '%lld' is greater than Number.MAX_SAFE_INTEGER", value);
-        assert(err == 0);
+  void
+  operator=(const js_escapable_scope_t &) = delete;
 
-        return js_pending_exception;
-      }
-    }
+  template <typename T>
+  int
+  escape(const T &handle, T &result) {
+    int err;
 
-    return js_create_int64(env, value, &result);
-  }
+    js_value_t *value;
+    err = js_escape_handle(env_, scope_, static_cast<js_value_t *>(handle), &value);
+    if (err < 0) return err;
 
-  static auto
-  unmarshall(int64_t value, int64_t &result) {
-    result = value;
+    result = T(value);
 
     return 0;
   }
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *, int64_t value, int64_t &result) {
-    return unmarshall(value, result);
-  }
+  void
+  close() {
+    if (scope_ == nullptr) return;
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, int64_t &result) {
-    if constexpr (options.checked) {
-      int err;
-      err = js_check_value<js_is_int64>(env, value, "int64");
-      if (err < 0) return err;
-    }
+    int err;
+    err = js_close_escapable_handle_scope(env_, scope_);
+    assert(err == 0);
 
-    return js_get_value_int64(env, value, &result);
+    scope_ = nullptr;
   }
+
+private:
+  js_env_t *env_;
+  js_escapable_handle_scope_t *scope_;
 };
 
-template <>
-struct js_type_info_t<uint64_t> {
-  using type = uint64_t;
+template <size_t batch = 1024, typename F>
+static inline int
+js_for_each_scoped(js_env_t *env, size_t len, F &&fn) {
+  static_assert(batch > 0);
 
-  static constexpr auto signature = js_uint64;
+  int err;
 
-  static auto
-  marshall(uint64_t value, uint64_t &result) {
-    result = value;
+  size_t i = 0;
 
-    return 0;
-  }
+  while (i < len) {
+    js_scope_t scope(env);
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *, uint64_t value, uint64_t &result) {
-    return marshall(value, result);
+    for (size_t end = std::min(len, i + batch); i < end; i++) {
+      if constexpr (std::is_void_v<std::invoke_result_t<F &, size_t>>) {
+        fn(i);
+      } else {
+        err = fn(i);
+        if (err < 0) return err;
+      }
+    }
   }
 
-  template <js_type_options_t options>
-  static int
-  marshall(js_env_t *env, uint64_t value, js_value_t *&result) {
-    if (options.checked) {
-      int err;
+  return 0;
+}
 
-      if (value > js_max_safe_integer) {
-        err = js_throw_range_errorf(env, nullptr, "Value '%llu' is greater than Number.MAX_SAFE_INTEGER", value);
-        assert(err == 0);
+template <int check(js_env_t *, js_value_t *, bool *result)>
+static inline int
+js_check_value(js_env_t *env, js_value_t *value, const char *label) {
+  int err;
 
-        return js_pending_exception;
-      }
-    }
+  bool is_type;
+  err = check(env, value, &is_type);
+  if (err < 0) return err;
 
-    return js_create_int64(env, int64_t(value), &result);
-  }
+  if (is_type) return 0;
 
-  static auto
-  unmarshall(uint64_t value, uint64_t &result) {
-    result = value;
+  err = js_throw_type_errorf(env, nullptr, "Value is not of type '%s'", label);
+  assert(err == 0);
 
-    return 0;
-  }
+  return js_pending_exception;
+}
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *, uint64_t value, uint64_t &result) {
-    return unmarshall(value, result);
-  }
+template <int check(js_env_t *, const js_handle_t &, bool &result)>
+static inline int
+js_check_value(js_env_t *env, js_value_t *value, const char *label) {
+  int err;
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, uint64_t &result) {
-    int err;
+  bool is_type;
+  err = check(env, js_handle_t(value), is_type);
+  if (err < 0) return err;
 
-    if constexpr (options.checked) {
-      err = js_check_value<js_is_uint64>(env, value, "uint64");
-      if (err < 0) return err;
-    }
+  if (is_type) return 0;
 
-    int64_t unmarshalled;
-    err = js_get_value_int64(env, value, &unmarshalled);
-    if (err < 0) return err;
+  err = js_throw_type_errorf(env, nullptr, "Value is not of type '%s'", label);
+  assert(err == 0);
 
-    result = uint64_t(unmarshalled);
+  return js_pending_exception;
+}
 
-    return 0;
-  }
-};
+template <typename T>
+struct js_typedarray_info_t;
 
 template <>
-struct js_type_info_t<double> {
-  using type = double;
+struct js_typedarray_info_t<int8_t> {
+  static constexpr auto type = js_int8array;
 
-  static constexpr auto signature = js_float64;
+  static constexpr auto label = "int8array";
 
   static auto
-  marshall(double value, double &result) {
-    result = value;
-
-    return 0;
+  is(js_env_t *env, const js_handle_t &value, bool &result) {
+    return js_is_int8array(env, static_cast<js_value_t *>(value), &result);
   }
+};
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *, double value, double &result) {
-    return marshall(value, result);
-  }
+template <>
+struct js_typedarray_info_t<uint8_t> {
+  static constexpr auto type = js_uint8array;
+
+  static constexpr auto label = "uint8array";
 
-  template <js_type_options_t options>
   static auto
-  marshall(js_env_t *env, double value, js_value_t *&result) {
-    return js_create_double(env, value, &result);
+  is(js_env_t *env, const js_handle_t &value, bool &result) {
+    return js_is_uint8array(env, static_cast<js_value_t *>(value), &result);
   }
+};
 
-  static auto
-  unmarshall(double value, double &result) {
-    result = value;
+template <>
+struct js_typedarray_info_t<int16_t> {
+  static constexpr auto type = js_int16array;
 
-    return 0;
-  }
+  static constexpr auto label = "int16array";
 
-  template <js_type_options_t options>
   static auto
-  unmarshall(js_env_t *, double value, double &result) {
-    return unmarshall(value, result);
+  is(js_env_t *env, const js_handle_t &value, bool &result) {
+    return js_is_int16array(env, static_cast<js_value_t *>(value), &result);
   }
+};
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, double &result) {
-    if constexpr (options.checked) {
-      int err;
-      err = js_check_value<js_is_number>(env, value, "double");
-      if (err < 0) return err;
-    }
+template <>
+struct js_typedarray_info_t<uint16_t> {
+  static constexpr auto type = js_uint16array;
 
-    return js_get_value_double(env, value, &result);
+  static constexpr auto label = "uint16array";
+
+  static auto
+  is(js_env_t *env, const js_handle_t &value, bool &result) {
+    return js_is_uint16array(env, static_cast<js_value_t *>(value), &result);
   }
 };
 
 template <>
-struct js_type_info_t<js_bigint_t> {
-  using type = js_value_t *;
+struct js_typedarray_info_t<int32_t> {
+  static constexpr auto type = js_int32array;
 
-  static constexpr auto signature = js_bigint;
+  static constexpr auto label = "int32array";
 
-  template <js_type_options_t options>
   static auto
-  marshall(js_env_t *, js_bigint_t &bigint, js_value_t *&result) {
-    result = static_cast<js_value_t *>(bigint);
-
-    return 0;
+  is(js_env_t *env, const js_handle_t &value, bool &result) {
+    return js_is_int32array(env, static_cast<js_value_t *>(value), &result);
   }
+};
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_bigint_t &result) {
-    if constexpr (options.checked) {
-      int err;
-      err = js_check_value<js_is_bigint>(env, value, "bigint");
-      if (err < 0) return err;
-    }
+template <>
+struct js_typedarray_info_t<uint32_t> {
+  static constexpr auto type = js_uint32array;
 
-    result = js_bigint_t(value);
+  static constexpr auto label = "uint32array";
 
-    return 0;
+  static auto
+  is(js_env_t *env, const js_handle_t &value, bool &result) {
+    return js_is_uint32array(env, static_cast<js_value_t *>(value), &result);
   }
 };
 
-struct js_bigint64_t {
-  js_bigint64_t() : value_(0) {}
+template <>
+struct js_typedarray_info_t<int64_t> {
+  static constexpr auto type = js_bigint64array;
 
-  js_bigint64_t(int64_t value) : value_(value) {}
+  static constexpr auto label = "bigint64array";
 
-  operator int64_t() const {
-    return value_;
+  static auto
+  is(js_env_t *env, const js_handle_t &value, bool &result) {
+    return js_is_bigint64array(env, static_cast<js_value_t *>(value), &result);
   }
-
-private:
-  int64_t value_;
 };
 
 template <>
-struct js_type_info_t<js_bigint64_t> {
-  using type = int64_t;
+struct js_typedarray_info_t<uint64_t> {
+  static constexpr auto type = js_biguint64array;
 
-  static constexpr auto signature = js_bigint64;
+  static constexpr auto label = "biguint64array";
 
   static auto
-  marshall(js_bigint64_t value, int64_t &result) {
-    result = value;
-
-    return 0;
+  is(js_env_t *env, const js_handle_t &value, bool &result) {
+    return js_is_biguint64array(env, static_cast<js_value_t *>(value), &result);
   }
+};
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *, js_bigint64_t value, int64_t &result) {
-    return marshall(value, result);
-  }
+template <>
+struct js_typedarray_info_t<float> {
+  static constexpr auto type = js_float32array;
+
+  static constexpr auto label = "float32array";
 
-  template <js_type_options_t options>
   static auto
-  marshall(js_env_t *env, js_bigint64_t value, js_value_t *&result) {
-    return js_create_bigint_int64(env, value, &result);
+  is(js_env_t *env, const js_handle_t &value, bool &result) {
+    return js_is_float32array(env, static_cast<js_value_t *>(value), &result);
   }
+};
 
-  static auto
-  unmarshall(int64_t value, js_bigint64_t &result) {
-    result = value;
+template <>
+struct js_typedarray_info_t<double> {
+  static constexpr auto type = js_float64array;
 
-    return 0;
-  }
+  static constexpr auto label = "float64array";
 
-  template <js_type_options_t options>
   static auto
-  unmarshall(js_env_t *, int64_t value, js_bigint64_t &result) {
-    return unmarshall(value, result);
+  is(js_env_t *env, const js_handle_t &value, bool &result) {
+    return js_is_float64array(env, static_cast<js_value_t *>(value), &result);
   }
+};
+
+template <>
+struct js_typedarray_info_t<js_typedarray_element_any> {
+  static constexpr auto label = "typedarray";
 
-  template <js_type_options_t options>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_bigint64_t &result) {
-    int err;
+  is(js_env_t *env, const js_handle_t &value, bool &result) {
+    return js_is_typedarray(env, static_cast<js_value_t *>(value), &result);
+  }
+};
 
-    if constexpr (options.checked) {
-      err = js_check_value<js_is_bigint>(env, value, "bigint");
-      if (err < 0) return err;
-    }
+template <typename T = js_typedarray_element_any>
+static inline auto
+js_is_typedarray(js_env_t *env, const js_handle_t &value, bool &result) {
+  return js_typedarray_info_t<T>::is(env, value, result);
+}
 
-    int64_t bigint;
-    err = js_get_value_bigint_int64(env, value, &bigint, nullptr);
-    if (err < 0) return err;
+struct js_type_options_t {
+  bool checked = js_is_debug;
 
-    result = bigint;
+  constexpr js_type_options_t() = default;
 
-    return 0;
-  }
+  constexpr js_type_options_t(const js_type_options_t &that) : checked(that.checked) {}
 };
 
-struct js_biguint64_t {
-  js_biguint64_t() : value_(0) {}
+template <typename T>
+struct js_type_info_t;
 
-  js_biguint64_t(uint64_t value) : value_(value) {}
+template <>
+struct js_type_info_t<void> {
+  using type = void;
 
-  operator uint64_t() const {
-    return value_;
-  }
+  static constexpr auto signature = js_undefined;
 
-private:
-  uint64_t value_;
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, js_value_t *&result) {
+    return js_get_undefined(env, &result);
+  }
 };
 
 template <>
-struct js_type_info_t<js_biguint64_t> {
-  using type = uint64_t;
+struct js_type_info_t<bool> {
+  using type = bool;
 
-  static constexpr auto signature = js_biguint64;
+  static constexpr auto signature = js_boolean;
 
   static auto
-  marshall(uint64_t value, uint64_t &result) {
+  marshall(bool value, bool &result) {
     result = value;
 
     return 0;
@@ -979,18 +1005,18 @@ struct js_type_info_t<js_biguint64_t> {
 
   template <js_type_options_t options>
   static auto
-  marshall(js_env_t *, js_biguint64_t value, uint64_t &result) {
+  marshall(js_env_t *, bool value, bool &result) {
     return marshall(value, result);
   }
 
   template <js_type_options_t options>
   static auto
-  marshall(js_env_t *env, js_biguint64_t value, js_value_t *&result) {
-    return js_create_bigint_uint64(env, value, &result);
+  marshall(js_env_t *env, bool value, js_value_t *&result) {
+    return js_get_boolean(env, value, &result);
   }
 
   static auto
-  unmarshall(uint64_t value, js_biguint64_t &result) {
+  unmarshall(bool value, bool &result) {
     result = value;
 
     return 0;
@@ -998,587 +1024,759 @@ struct js_type_info_t<js_biguint64_t> {
 
   template <js_type_options_t options>
   static auto
-  unmarshall(js_env_t *, uint64_t value, js_biguint64_t &result) {
+  unmarshall(js_env_t *, bool value, bool &result) {
     return unmarshall(value, result);
   }
 
   template <js_type_options_t options>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_biguint64_t &result) {
-    int err;
-
+  unmarshall(js_env_t *env, js_value_t *value, bool &result) {
     if constexpr (options.checked) {
-      err = js_check_value<js_is_bigint>(env, value, "bigint");
+      int err;
+      err = js_check_value<js_is_boolean>(env, value, "boolean");
       if (err < 0) return err;
     }
 
-    uint64_t bigint;
-    err = js_get_value_bigint_uint64(env, value, &bigint, nullptr);
+    return js_get_value_bool(env, value, &result);
+  }
+};
+
+constexpr int64_t js_min_safe_integer = -9007199254740991;
+
+constexpr int64_t js_max_safe_integer = 9007199254740991;
+
+static inline auto
+js_is_int64(js_env_t *env, const js_handle_t &value, bool &result) {
+  int err;
+  err = js_is_number(env, static_cast<js_value_t *>(value), &result);
+  if (err < 0) return err;
+
+  if (result == false) return 0;
+
+  double n, i;
+  err = js_get_value_double(env, static_cast<js_value_t *>(value), &n);
+  if (err < 0) return err;
+
+  result = modf(n, &i) == 0.0 && i >= js_min_safe_integer && i <= js_max_safe_integer;
+
+  return 0;
+}
+
+static inline auto
+js_is_uint64(js_env_t *env, const js_handle_t &value, bool &result) {
+  int err;
+  err = js_is_number(env, static_cast<js_value_t *>(value), &result);
+  if (err < 0) return err;
+
+  if (result == false) return 0;
+
+  double n, i;
+  err = js_get_value_double(env, static_cast<js_value_t *>(value), &n);
+  if (err < 0) return err;
+
+  result = modf(n, &i) == 0.0 && i >= 0.0 && i <= js_max_safe_integer;
+
+  return 0;
+}
+
+template <typename T>
+static inline int
+js_get_value_checked_integer(js_env_t *env, js_value_t *value, double min, double max, const char *label, T &result) {
+  int err;
+
+  bool is_number;
+  err = js_is_number(env, value, &is_number);
+  if (err < 0) return err;
+
+  double n = 0, i;
+
+  if (is_number) {
+    err = js_get_value_double(env, value, &n);
     if (err < 0) return err;
+  }
 
-    result = bigint;
+  if (!is_number || modf(n, &i) != 0.0 || i < min || i > max) {
+    err = js_throw_type_errorf(env, nullptr, "Value is not of type '%s'", label);
+    assert(err == 0);
 
-    return 0;
+    return js_pending_exception;
   }
-};
+
+  result = T(i);
+
+  return 0;
+}
 
 template <>
-struct js_type_info_t<js_handle_t> {
-  using type = js_value_t *;
+struct js_type_info_t<int32_t> {
+  using type = int32_t;
 
-  static constexpr auto signature = js_object;
+  static constexpr auto signature = js_int32;
 
-  template <js_type_options_t options>
   static auto
-  marshall(js_env_t *, js_handle_t &value, js_value_t *&result) {
-    result = static_cast<js_value_t *>(value);
+  marshall(int32_t value, int32_t &result) {
+    result = value;
 
     return 0;
   }
 
   template <js_type_options_t options>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_handle_t &result) {
-    result = js_handle_t(value);
+  marshall(js_env_t *, int32_t value, int32_t &result) {
+    return marshall(value, result);
+  }
 
-    return 0;
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, int32_t value, js_value_t *&result) {
+    return js_create_int32(env, value, &result);
   }
-};
 
-template <>
-struct js_type_info_t<js_string_t> {
-  using type = js_value_t *;
+  static auto
+  unmarshall(int32_t value, int32_t &result) {
+    result = value;
 
-  static constexpr auto signature = js_string;
+    return 0;
+  }
 
   template <js_type_options_t options>
   static auto
-  marshall(js_env_t *, js_string_t &string, js_value_t *&result) {
-    result = static_cast<js_value_t *>(string);
-
-    return 0;
+  unmarshall(js_env_t *, int32_t value, int32_t &result) {
+    return unmarshall(value, result);
   }
 
   template <js_type_options_t options>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_string_t &result) {
+  unmarshall(js_env_t *env, js_value_t *value, int32_t &result) {
     if constexpr (options.checked) {
-      int err;
-      err = js_check_value<js_is_string>(env, value, "string");
-      if (err < 0) return err;
+      return js_get_value_checked_integer(env, value, INT32_MIN, INT32_MAX, "int32", result);
     }
 
-    result = js_string_t(value);
-
-    return 0;
+    return js_get_value_int32(env, value, &result);
   }
 };
 
 template <>
-struct js_type_info_t<js_symbol_t> {
-  using type = js_value_t *;
+struct js_type_info_t<uint32_t> {
+  using type = uint32_t;
 
-  static constexpr auto signature = js_symbol;
+  static constexpr auto signature = js_uint32;
 
-  template <js_type_options_t options>
   static auto
-  marshall(js_env_t *, js_symbol_t &symbol, js_value_t *&result) {
-    result = static_cast<js_value_t *>(symbol);
+  marshall(uint32_t value, uint32_t &result) {
+    result = value;
 
     return 0;
   }
 
   template <js_type_options_t options>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_symbol_t &result) {
-    if constexpr (options.checked) {
-      int err;
-      err = js_check_value<js_is_symbol>(env, value, "symbol");
-      if (err < 0) return err;
-    }
-
-    result = js_symbol_t(value);
+  marshall(js_env_t *, uint32_t value, uint32_t &result) {
+    return marshall(value, result);
+  }
 
-    return 0;
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, uint32_t value, js_value_t *&result) {
+    return js_create_uint32(env, value, &result);
   }
-};
 
-template <>
-struct js_type_info_t<js_object_t> {
-  using type = js_value_t *;
+  static auto
+  unmarshall(uint32_t value, uint32_t &result) {
+    result = value;
 
-  static constexpr auto signature = js_object;
+    return 0;
+  }
 
   template <js_type_options_t options>
   static auto
-  marshall(js_env_t *, js_object_t &object, js_value_t *&result) {
-    result = static_cast<js_value_t *>(object);
-
-    return 0;
+  unmarshall(js_env_t *, uint32_t value, uint32_t &result) {
+    return unmarshall(value, result);
   }
 
   template <js_type_options_t options>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_object_t &result) {
+  unmarshall(js_env_t *env, js_value_t *value, uint32_t &result) {
     if constexpr (options.checked) {
-      int err;
-      err = js_check_value<js_is_object>(env, value, "object");
-      if (err < 0) return err;
+      return js_get_value_checked_integer(env, value, 0, UINT32_MAX, "uint32", result);
     }
 
-    result = js_object_t(value);
-
-    return 0;
+    return js_get_value_uint32(env, value, &result);
   }
 };
 
 template <>
-struct js_type_info_t<js_array_t> {
-  using type = js_value_t *;
+struct js_type_info_t<int64_t> {
+  using type = int64_t;
 
-  static constexpr auto signature = js_object;
+  static constexpr auto signature = js_int64;
 
-  template <js_type_options_t options>
   static auto
-  marshall(js_env_t *, js_array_t &array, js_value_t *&result) {
-    result = static_cast<js_value_t *>(array);
+  marshall(int64_t value, int64_t &result) {
+    result = value;
 
     return 0;
   }
 
   template <js_type_options_t options>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_array_t &result) {
-    if constexpr (options.checked) {
+  marshall(js_env_t *, int64_t value, int64_t &result) {
+    return marshall(value, result);
+  }
+
+  template <js_type_options_t options>
+  static int
+  marshall(js_env_t *env, int64_t value, js_value_t *&result) {
+    if (options.checked) {
       int err;
-      err = js_check_value<js_is_array>(env, value, "array");
-      if (err < 0) return err;
-    }
 
-    result = js_array_t(value);
+      if (value < js_min_safe_integer) {
+        err = js_throw_range_errorf(env, nullptr, "Value '%lld' is less than Number.MIN_SAFE_INTEGER", value);
+        assert(err == 0);
 
-    return 0;
-  }
-};
+        return js_pending_exception;
+      }
 
-template <>
-struct js_type_info_t<js_arraybuffer_t> {
-  using type = js_value_t *;
+      if (value > js_max_safe_integer) {
+        err = js_throw_range_errorf(env, nullptr, "Value '%lld' is greater than Number.MAX_SAFE_INTEGER", value);
+        assert(err == 0);
 
-  static constexpr auto signature = js_object;
+        return js_pending_exception;
+      }
+    }
+
+    return js_create_int64(env, value, &result);
+  }
 
-  template <js_type_options_t options>
   static auto
-  marshall(js_env_t *, js_arraybuffer_t &arraybuffer, js_value_t *&result) {
-    result = static_cast<js_value_t *>(arraybuffer);
+  unmarshall(int64_t value, int64_t &result) {
+    result = value;
 
     return 0;
   }
 
   template <js_type_options_t options>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_arraybuffer_t &result) {
+  unmarshall(js_env_t *, int64_t value, int64_t &result) {
+    return unmarshall(value, result);
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, int64_t &result) {
     if constexpr (options.checked) {
-      int err;
-      err = js_check_value<js_is_arraybuffer>(env, value, "arraybuffer");
-      if (err < 0) return err;
+      return js_get_value_checked_integer(env, value, js_min_safe_integer, js_max_safe_integer, "int64", result);
     }
 
-    result = js_arraybuffer_t(value);
-
-    return 0;
+    return js_get_value_int64(env, value, &result);
   }
 };
 
-namespace {
-
-template <typename T>
-static T js_arraybuffer_span_nil[1] = {T()};
-
-} // namespace
-
-struct js_arraybuffer_span_t {
-  js_arraybuffer_span_t() : data_(js_arraybuffer_span_nil<uint8_t>), size_(0) {}
+template <>
+struct js_type_info_t<uint64_t> {
+  using type = uint64_t;
 
-  js_arraybuffer_span_t(uint8_t *data, size_t len) : data_(len == 0 ? js_arraybuffer_span_nil<uint8_t> : data), size_(len) {}
+  static constexpr auto signature = js_uint64;
 
-  uint8_t &
-  operator[](size_t i) {
-    return data_[i];
-  }
+  static auto
+  marshall(uint64_t value, uint64_t &result) {
+    result = value;
 
-  const uint8_t
-  operator[](size_t i) const {
-    return data_[i];
+    return 0;
   }
 
-  uint8_t *
-  data() const {
-    return data_;
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *, uint64_t value, uint64_t &result) {
+    return marshall(value, result);
   }
 
-  size_t
-  size() const {
-    return size_;
-  }
+  template <js_type_options_t options>
+  static int
+  marshall(js_env_t *env, uint64_t value, js_value_t *&result) {
+    if (options.checked) {
+      int err;
 
-  template <typename T>
-  size_t
-  size() const {
-    return size_ / sizeof(T);
-  }
+      if (value > js_max_safe_integer) {
+        err = js_throw_range_errorf(env, nullptr, "Value '%llu' is greater than Number.MAX_SAFE_INTEGER", value);
+        assert(err == 0);
 
-  size_t
-  size_bytes() const {
-    return size_;
-  }
+        return js_pending_exception;
+      }
+    }
 
-  bool
-  empty() const {
-    return size_ == 0;
+    return js_create_int64(env, int64_t(value), &result);
   }
 
-  uint8_t *
-  begin() const {
-    return data_;
-  }
+  static auto
+  unmarshall(uint64_t value, uint64_t &result) {
+    result = value;
 
-  uint8_t *
-  end() const {
-    return data_ + size_;
+    return 0;
   }
 
-private:
-  uint8_t *data_;
-  size_t size_;
-};
-
-template <>
-struct js_type_info_t<js_arraybuffer_span_t> {
-  using type = js_value_t *;
-
-  static constexpr auto signature = js_object;
-
   template <js_type_options_t options>
   static auto
-  marshall(js_env_t *env, js_arraybuffer_span_t &view, js_value_t *&result) {
-    int err;
-
-    uint8_t *data;
-    err = js_create_arraybuffer(env, view.size(), reinterpret_cast<void **>(&data), &result);
-    if (err < 0) return err;
-
-    std::copy(view.begin(), view.end(), data);
-
-    return 0;
+  unmarshall(js_env_t *, uint64_t value, uint64_t &result) {
+    return unmarshall(value, result);
   }
 
   template <js_type_options_t options>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_arraybuffer_span_t &result) {
-    int err;
-
+  unmarshall(js_env_t *env, js_value_t *value, uint64_t &result) {
     if constexpr (options.checked) {
-      err = js_check_value<js_is_arraybuffer>(env, value, "arraybuffer");
-      if (err < 0) return err;
+      return js_get_value_checked_integer(env, value, 0, js_max_safe_integer, "uint64", result);
     }
 
-    uint8_t *data;
-    size_t len;
-    err = js_get_arraybuffer_info(env, value, reinterpret_cast<void **>(&data), &len);
+    int err;
+
+    int64_t unmarshalled;
+    err = js_get_value_int64(env, value, &unmarshalled);
     if (err < 0) return err;
 
-    result = js_arraybuffer_span_t(data, len);
+    result = uint64_t(unmarshalled);
 
     return 0;
   }
 };
 
-constexpr auto js_arraybuffer_span_dynamic = size_t(-1);
+template <>
+struct js_type_info_t<double> {
+  using type = double;
 
-template <typename T, size_t N = js_arraybuffer_span_dynamic>
-struct js_arraybuffer_span_of_t;
+  static constexpr auto signature = js_float64;
 
-template <typename T>
-struct js_arraybuffer_span_of_t<T, 1> {
-  js_arraybuffer_span_of_t() : data_(nullptr) {}
+  static auto
+  marshall(double value, double &result) {
+    result = value;
 
-  js_arraybuffer_span_of_t(T *data) : data_(data) {}
+    return 0;
+  }
 
-  operator T *() const {
-    return data_;
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *, double value, double &result) {
+    return marshall(value, result);
   }
 
-  T *
-  operator->() const {
-    return data_;
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, double value, js_value_t *&result) {
+    return js_create_double(env, value, &result);
   }
 
-  T &
-  operator*() {
-    return *data_;
+  static auto
+  unmarshall(double value, double &result) {
+    result = value;
+
+    return 0;
   }
 
-  const T &
-  operator*() const {
-    return *data_;
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *, double value, double &result) {
+    return unmarshall(value, result);
   }
 
-private:
-  T *data_;
-};
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, double &result) {
+    if constexpr (options.checked) {
+      int err;
+      err = js_check_value<js_is_number>(env, value, "double");
+      if (err < 0) return err;
+    }
 
-template <typename T>
-js_arraybuffer_span_of_t(T *data) -> js_arraybuffer_span_of_t<T, 1>;
+    return js_get_value_double(env, value, &result);
+  }
+};
 
-template <typename T>
-struct js_arraybuffer_span_of_t<T, js_arraybuffer_span_dynamic> {
-  js_arraybuffer_span_of_t() : data_(js_arraybuffer_span_nil<T>), size_(0) {}
+template <>
+struct js_type_info_t<js_bigint_t> {
+  using type = js_value_t *;
 
-  js_arraybuffer_span_of_t(T *data, size_t len) : data_(len == 0 ? js_arraybuffer_span_nil<T> : data), size_(len) {}
+  static constexpr auto signature = js_bigint;
 
-  T &
-  operator[](size_t i) {
-    return data_[i];
-  }
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *, js_bigint_t &bigint, js_value_t *&result) {
+    result = static_cast<js_value_t *>(bigint);
 
-  const T
-  operator[](size_t i) const {
-    return data_[i];
+    return 0;
   }
 
-  T *
-  data() const {
-    return data_;
-  }
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, js_bigint_t &result) {
+    if constexpr (options.checked) {
+      int err;
+      err = js_check_value<js_is_bigint>(env, value, "bigint");
+      if (err < 0) return err;
+    }
 
-  size_t
-  size() const {
-    return size_;
-  }
+    result = js_bigint_t(value);
 
-  size_t
-  size_bytes() const {
-    return size_ * sizeof(T);
+    return 0;
   }
+};
 
-  bool
-  empty() const {
-    return size_ == 0;
-  }
+struct js_bigint64_t {
+  js_bigint64_t() : value_(0) {}
 
-  T *
-  begin() const {
-    return data_;
-  }
+  js_bigint64_t(int64_t value) : value_(value) {}
 
-  T *
-  end() const {
-    return data_ + size_;
+  operator int64_t() const {
+    return value_;
   }
 
 private:
-  T *data_;
-  size_t size_;
+  int64_t value_;
 };
 
-template <typename T>
-js_arraybuffer_span_of_t(T *data, size_t len) -> js_arraybuffer_span_of_t<T>;
+template <>
+struct js_type_info_t<js_bigint64_t> {
+  using type = int64_t;
 
-template <typename T>
-struct js_type_info_t<js_arraybuffer_span_of_t<T, 1>> {
-  using type = js_value_t *;
+  static constexpr auto signature = js_bigint64;
 
-  static constexpr auto signature = js_object;
+  static auto
+  marshall(js_bigint64_t value, int64_t &result) {
+    result = value;
+
+    return 0;
+  }
 
   template <js_type_options_t options>
   static auto
-  marshall(js_env_t *env, js_arraybuffer_span_of_t<T, 1> &view, js_value_t *&result) {
-    int err;
+  marshall(js_env_t *, js_bigint64_t value, int64_t &result) {
+    return marshall(value, result);
+  }
 
-    T *data;
-    err = js_create_arraybuffer(env, sizeof(T), reinterpret_cast<void **>(&data), &result);
-    if (err < 0) return err;
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, js_bigint64_t value, js_value_t *&result) {
+    return js_create_bigint_int64(env, value, &result);
+  }
 
-    *data = *view;
+  static auto
+  unmarshall(int64_t value, js_bigint64_t &result) {
+    result = value;
 
     return 0;
   }
 
   template <js_type_options_t options>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_arraybuffer_span_of_t<T, 1> &result) {
+  unmarshall(js_env_t *, int64_t value, js_bigint64_t &result) {
+    return unmarshall(value, result);
+  }
+
+  template <js_type_options_t options>
+  static int
+  unmarshall(js_env_t *env, js_value_t *value, js_bigint64_t &result) {
     int err;
 
+    int64_t bigint;
+
     if constexpr (options.checked) {
-      err = js_check_value<js_is_arraybuffer>(env, value, "arraybuffer");
+      err = js_check_value<js_is_bigint>(env, value, "bigint");
       if (err < 0) return err;
-    }
 
-    T *data;
-    size_t len;
-    err = js_get_arraybuffer_info(env, value, reinterpret_cast<void **>(&data), &len);
-    if (err < 0) return err;
+      bool lossless;
+      err = js_get_value_bigint_int64(env, value, &bigint, &lossless);
+      if (err < 0) return err;
 
-    assert(len == sizeof(T));
+      if (!lossless) {
+        err = js_throw_range_error(env, nullptr, "Value is out of range of type 'bigint64'");
+        assert(err == 0);
 
-    result = js_arraybuffer_span_of_t<T, 1>(data);
+        return js_pending_exception;
+      }
+    } else {
+      err = js_get_value_bigint_int64(env, value, &bigint, nullptr);
+      if (err < 0) return err;
+    }
+
+    result = bigint;
 
     return 0;
   }
 };
 
-template <typename T>
-struct js_type_info_t<js_arraybuffer_span_of_t<T>> {
+struct js_biguint64_t {
+  js_biguint64_t() : value_(0) {}
+
+  js_biguint64_t(uint64_t value) : value_(value) {}
+
+  operator uint64_t() const {
+    return value_;
+  }
+
+private:
+  uint64_t value_;
+};
+
+template <>
+struct js_type_info_t<js_biguint64_t> {
+  using type = uint64_t;
+
+  static constexpr auto signature = js_biguint64;
+
+  static auto
+  marshall(uint64_t value, uint64_t &result) {
+    result = value;
+
+    return 0;
+  }
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *, js_biguint64_t value, uint64_t &result) {
+    return marshall(value, result);
+  }
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, js_biguint64_t value, js_value_t *&result) {
+    return js_create_bigint_uint64(env, value, &result);
+  }
+
+  static auto
+  unmarshall(uint64_t value, js_biguint64_t &result) {
+    result = value;
+
+    return 0;
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *, uint64_t value, js_biguint64_t &result) {
+    return unmarshall(value, result);
+  }
+
+  template <js_type_options_t options>
+  static int
+  unmarshall(js_env_t *env, js_value_t *value, js_biguint64_t &result) {
+    int err;
+
+    uint64_t bigint;
+
+    if constexpr (options.checked) {
+      err = js_check_value<js_is_bigint>(env, value, "bigint");
+      if (err < 0) return err;
+
+      bool lossless;
+      err = js_get_value_bigint_uint64(env, value, &bigint, &lossless);
+      if (err < 0) return err;
+
+      if (!lossless) {
+        err = js_throw_range_error(env, nullptr, "Value is out of range of type 'biguint64'");
+        assert(err == 0);
+
+        return js_pending_exception;
+      }
+    } else {
+      err = js_get_value_bigint_uint64(env, value, &bigint, nullptr);
+      if (err < 0) return err;
+    }
+
+    result = bigint;
+
+    return 0;
+  }
+};
+
+template <>
+struct js_type_info_t<js_handle_t> {
   using type = js_value_t *;
 
   static constexpr auto signature = js_object;
 
   template <js_type_options_t options>
   static auto
-  marshall(js_env_t *env, js_arraybuffer_span_of_t<T> &view, js_value_t *&result) {
-    int err;
+  marshall(js_env_t *, js_handle_t &value, js_value_t *&result) {
+    result = static_cast<js_value_t *>(value);
 
-    T *data;
-    err = js_create_arraybuffer(env, view.size_bytes(), reinterpret_cast<void **>(&data), &result);
-    if (err < 0) return err;
+    return 0;
+  }
 
-    std::copy(view.begin(), view.end(), data);
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, js_handle_t &result) {
+    result = js_handle_t(value);
 
     return 0;
   }
+};
+
+template <>
+struct js_type_info_t<js_string_t> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_string;
 
   template <js_type_options_t options>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_arraybuffer_span_of_t<T> &result) {
-    int err;
+  marshall(js_env_t *, js_string_t &string, js_value_t *&result) {
+    result = static_cast<js_value_t *>(string);
+
+    return 0;
+  }
 
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, js_string_t &result) {
     if constexpr (options.checked) {
-      err = js_check_value<js_is_arraybuffer>(env, value, "arraybuffer");
+      int err;
+      err = js_check_value<js_is_string>(env, value, "string");
       if (err < 0) return err;
     }
 
-    T *data;
-    size_t len;
-    err = js_get_arraybuffer_info(env, value, reinterpret_cast<void **>(&data), &len);
-    if (err < 0) return err;
+    result = js_string_t(value);
 
-    assert(len % sizeof(T) == 0);
+    return 0;
+  }
+};
 
-    result = js_arraybuffer_span_of_t<T>(data, len / sizeof(T));
+template <>
+struct js_type_info_t<js_symbol_t> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_symbol;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *, js_symbol_t &symbol, js_value_t *&result) {
+    result = static_cast<js_value_t *>(symbol);
+
+    return 0;
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, js_symbol_t &result) {
+    if constexpr (options.checked) {
+      int err;
+      err = js_check_value<js_is_symbol>(env, value, "symbol");
+      if (err < 0) return err;
+    }
+
+    result = js_symbol_t(value);
 
     return 0;
   }
 };
 
-template <js_typedarray_element T>
-struct js_type_info_t<js_typedarray_t<T>> {
+template <>
+struct js_type_info_t<js_object_t> {
   using type = js_value_t *;
 
   static constexpr auto signature = js_object;
 
   template <js_type_options_t options>
   static auto
-  marshall(js_env_t *, js_typedarray_t<T> &typedarray, js_value_t *&result) {
-    result = static_cast<js_value_t *>(typedarray);
+  marshall(js_env_t *, js_object_t &object, js_value_t *&result) {
+    result = static_cast<js_value_t *>(object);
 
     return 0;
   }
 
   template <js_type_options_t options>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_typedarray_t<T> &result) {
+  unmarshall(js_env_t *env, js_value_t *value, js_object_t &result) {
     if constexpr (options.checked) {
       int err;
-      err = js_check_value<js_is_typedarray<T>>(env, value, js_typedarray_info_t<T>::label);
+      err = js_check_value<js_is_object>(env, value, "object");
       if (err < 0) return err;
     }
 
-    result = js_typedarray_t<T>(value);
+    result = js_object_t(value);
 
     return 0;
   }
 };
 
 template <>
-struct js_type_info_t<js_typedarray_t<>> {
+struct js_type_info_t<js_array_t> {
   using type = js_value_t *;
 
   static constexpr auto signature = js_object;
 
   template <js_type_options_t options>
   static auto
-  marshall(js_env_t *, js_typedarray_t<> &typedarray, js_value_t *&result) {
-    result = static_cast<js_value_t *>(typedarray);
+  marshall(js_env_t *, js_array_t &array, js_value_t *&result) {
+    result = static_cast<js_value_t *>(array);
 
     return 0;
   }
 
   template <js_type_options_t options>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_typedarray_t<> &result) {
+  unmarshall(js_env_t *env, js_value_t *value, js_array_t &result) {
     if constexpr (options.checked) {
       int err;
-      err = js_check_value<js_is_typedarray<>>(env, value, "typedarray");
+      err = js_check_value<js_is_array>(env, value, "array");
       if (err < 0) return err;
     }
 
-    result = js_typedarray_t<>(value);
+    result = js_array_t(value);
 
     return 0;
   }
 };
 
-static inline size_t
-js_typedarray_element_size(js_typedarray_type_t type) {
-  switch (type) {
-  case js_int8array:
-  case js_uint8array:
-  case js_uint8clampedarray:
-  default:
-    return 1;
-  case js_int16array:
-  case js_uint16array:
-  case js_float16array:
-    return 2;
-  case js_int32array:
-  case js_uint32array:
-  case js_float32array:
-    return 4;
-  case js_bigint64array:
-  case js_biguint64array:
-  case js_float64array:
-    return 8;
+template <>
+struct js_type_info_t<js_arraybuffer_t> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_object;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *, js_arraybuffer_t &arraybuffer, js_value_t *&result) {
+    result = static_cast<js_value_t *>(arraybuffer);
+
+    return 0;
   }
-}
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, js_arraybuffer_t &result) {
+    if constexpr (options.checked) {
+      int err;
+      err = js_check_value<js_is_arraybuffer>(env, value, "arraybuffer");
+      if (err < 0) return err;
+    }
+
+    result = js_arraybuffer_t(value);
+
+    return 0;
+  }
+};
 
 namespace {
 
 template <typename T>
-static T js_typedarray_span_nil[1] = {T()};
-
-}
+static T js_arraybuffer_span_nil[1] = {T()};
 
-template <typename T = js_typedarray_element_any>
-struct js_typedarray_span_t;
+} // namespace
 
-template <js_typedarray_element T>
-struct js_typedarray_span_t<T> {
-  js_typedarray_span_t() : data_(js_typedarray_span_nil<T>), size_(0) {}
+struct js_arraybuffer_span_t {
+  js_arraybuffer_span_t() : data_(js_arraybuffer_span_nil<uint8_t>), size_(0) {}
 
-  js_typedarray_span_t(T *data, size_t len) : data_(len == 0 ? js_typedarray_span_nil<T> : data), size_(len) {}
+  js_arraybuffer_span_t(uint8_t *data, size_t len) : data_(len == 0 ? js_arraybuffer_span_nil<uint8_t> : data), size_(len) {}
 
-  T &
+  uint8_t &
   operator[](size_t i) {
     return data_[i];
   }
 
-  const T
+  const uint8_t
   operator[](size_t i) const {
     return data_[i];
   }
 
-  T *
+  uint8_t *
   data() const {
     return data_;
   }
@@ -1588,15 +1786,15 @@ struct js_typedarray_span_t<T> {
     return size_;
   }
 
-  template <typename U>
+  template <typename T>
   size_t
   size() const {
-    return size_ * sizeof(T) / sizeof(U);
+    return size_ / sizeof(T);
   }
 
   size_t
   size_bytes() const {
-    return size_ * sizeof(T);
+    return size_;
   }
 
   bool
@@ -1604,197 +1802,72 @@ struct js_typedarray_span_t<T> {
     return size_ == 0;
   }
 
-  T *
+  uint8_t *
   begin() const {
     return data_;
   }
 
-  T *
+  uint8_t *
   end() const {
     return data_ + size_;
   }
 
 private:
-  T *data_;
+  uint8_t *data_;
   size_t size_;
 };
 
-template <js_typedarray_element T>
-js_typedarray_span_t(T *data, size_t len) -> js_typedarray_span_t<T>;
-
-using js_int8array_span_t = js_typedarray_span_t<int8_t>;
-
-using js_uint8array_span_t = js_typedarray_span_t<uint8_t>;
-
-using js_int16array_span_t = js_typedarray_span_t<int16_t>;
-
-using js_uint16array_span_t = js_typedarray_span_t<uint16_t>;
-
-using js_int32array_span_t = js_typedarray_span_t<int32_t>;
-
-using js_uint32array_span_t = js_typedarray_span_t<uint32_t>;
-
-using js_bigint64array_span_t = js_typedarray_span_t<int64_t>;
-
-using js_biguint64array_span_t = js_typedarray_span_t<uint64_t>;
-
-using js_float32array_span_t = js_typedarray_span_t<float>;
-
-using js_float64array_span_t = js_typedarray_span_t<double>;
-
 template <>
-struct js_typedarray_span_t<js_typedarray_element_any> {
-  js_typedarray_span_t() : data_(nullptr), size_(0) {}
-
-  js_typedarray_span_t(void *data, size_t len, js_typedarray_type_t type) : data_(len == 0 ? nullptr : data), size_(len * js_typedarray_element_size(type)) {}
-
-  template <typename T>
-  js_typedarray_span_t(T *data, size_t len) : data_(len == 0 ? nullptr : data), size_(len * sizeof(T)) {}
-
-  template <typename T>
-  js_typedarray_span_t(const js_typedarray_span_t<T> &span) : data_(span.data()), size_(span.size_bytes()) {}
-
-  template <typename T = uint8_t>
-  T *
-  data() const {
-    return static_cast<T *>(data_);
-  }
-
-  template <typename T = uint8_t>
-  size_t
-  size() const {
-    return size_ / sizeof(T);
-  }
-
-  size_t
-  size_bytes() const {
-    return size_;
-  }
-
-  bool
-  empty() const {
-    return size_ == 0;
-  }
-
-  template <typename T = uint8_t>
-  T *
-  begin() const {
-    return data<T>();
-  }
-
-  template <typename T = uint8_t>
-  T *
-  end() const {
-    return data<T>() + size<T>();
-  }
-
-private:
-  void *data_;
-  size_t size_;
-};
-
-js_typedarray_span_t(void *data, size_t len, js_typedarray_type_t type) -> js_typedarray_span_t<js_typedarray_element_any>;
-
-template <typename T>
-js_typedarray_span_t(T *data, size_t len) -> js_typedarray_span_t<js_typedarray_element_any>;
-
-template <typename T>
-struct js_type_info_t<js_typedarray_span_t<T>> {
+struct js_type_info_t<js_arraybuffer_span_t> {
   using type = js_value_t *;
 
   static constexpr auto signature = js_object;
 
   template <js_type_options_t options>
   static auto
-  marshall(js_env_t *env, js_typedarray_span_t<T> &view, js_value_t *&result) {
+  marshall(js_env_t *env, js_arraybuffer_span_t &view, js_value_t *&result) {
     int err;
 
-    js_value_t *arraybuffer;
-
-    T *data;
-    err = js_create_arraybuffer(env, view.size_bytes(), reinterpret_cast<void **>(&data), &arraybuffer);
+    uint8_t *data;
+    err = js_create_arraybuffer(env, view.size(), reinterpret_cast<void **>(&data), &result);
     if (err < 0) return err;
 
     std::copy(view.begin(), view.end(), data);
 
-    return js_create_typedarray(env, js_typedarray_info_t<T>::type, view.size(), arraybuffer, 0, &result);
-  }
-
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_typedarray_span_t<T> &result) {
-    int err;
-
-    if constexpr (options.checked) {
-      err = js_check_value<js_is_typedarray<T>>(env, value, js_typedarray_info_t<T>::label);
-      if (err < 0) return err;
-    }
-
-    T *data;
-    size_t len;
-    err = js_get_typedarray_info(env, value, nullptr, reinterpret_cast<void **>(&data), &len, nullptr, nullptr);
-    if (err < 0) return err;
-
-    result = js_typedarray_span_t(data, len);
-
     return 0;
   }
-};
-
-template <>
-struct js_type_info_t<js_typedarray_span_t<>> {
-  using type = js_value_t *;
-
-  static constexpr auto signature = js_object;
-
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *env, js_typedarray_span_t<> &view, js_value_t *&result) {
-    int err;
-
-    js_value_t *arraybuffer;
-
-    void *data;
-    err = js_create_arraybuffer(env, view.size_bytes(), &data, &arraybuffer);
-    if (err < 0) return err;
-
-    std::copy(view.begin(), view.end(), static_cast<uint8_t *>(data));
-
-    return js_create_typedarray(env, js_uint8array, view.size_bytes(), arraybuffer, 0, &result);
-  }
 
   template <js_type_options_t options>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_typedarray_span_t<> &result) {
+  unmarshall(js_env_t *env, js_value_t *value, js_arraybuffer_span_t &result) {
     int err;
 
     if constexpr (options.checked) {
-      err = js_check_value<js_is_typedarray<>>(env, value, "typedarray");
+      err = js_check_value<js_is_arraybuffer>(env, value, "arraybuffer");
       if (err < 0) return err;
     }
 
-    void *data;
+    uint8_t *data;
     size_t len;
-    js_typedarray_type_t type;
-    err = js_get_typedarray_info(env, value, &type, &data, &len, nullptr, nullptr);
+    err = js_get_arraybuffer_info(env, value, reinterpret_cast<void **>(&data), &len);
     if (err < 0) return err;
 
-    result = js_typedarray_span_t(data, len, type);
+    result = js_arraybuffer_span_t(data, len);
 
     return 0;
   }
 };
 
-constexpr auto js_typedarray_span_dynamic = size_t(-1);
+constexpr auto js_arraybuffer_span_dynamic = size_t(-1);
 
-template <typename T, size_t N = js_typedarray_span_dynamic>
-struct js_typedarray_span_of_t;
+template <typename T, size_t N = js_arraybuffer_span_dynamic>
+struct js_arraybuffer_span_of_t;
 
 template <typename T>
-struct js_typedarray_span_of_t<T, 1> {
-  js_typedarray_span_of_t() : data_(nullptr) {}
+struct js_arraybuffer_span_of_t<T, 1> {
+  js_arraybuffer_span_of_t() : data_(nullptr) {}
 
-  js_typedarray_span_of_t(T *data) : data_(data) {}
+  js_arraybuffer_span_of_t(T *data) : data_(data) {}
 
   operator T *() const {
     return data_;
@@ -1820,13 +1893,13 @@ private:
 };
 
 template <typename T>
-js_typedarray_span_of_t(T *data) -> js_typedarray_span_of_t<T, 1>;
+js_arraybuffer_span_of_t(T *data) -> js_arraybuffer_span_of_t<T, 1>;
 
 template <typename T>
-struct js_typedarray_span_of_t<T, js_typedarray_span_dynamic> {
-  js_typedarray_span_of_t() : data_(js_typedarray_span_nil<T>), size_(0) {}
+struct js_arraybuffer_span_of_t<T, js_arraybuffer_span_dynamic> {
+  js_arraybuffer_span_of_t() : data_(js_arraybuffer_span_nil<T>), size_(0) {}
 
-  js_typedarray_span_of_t(T *data, size_t len) : data_(len == 0 ? js_typedarray_span_nil<T> : data), size_(len) {}
+  js_arraybuffer_span_of_t(T *data, size_t len) : data_(len == 0 ? js_arraybuffer_span_nil<T> : data), size_(len) {}
 
   T &
   operator[](size_t i) {
@@ -1874,26 +1947,21 @@ private:
 };
 
 template <typename T>
-js_typedarray_span_of_t(T *data, size_t len) -> js_typedarray_span_of_t<T>;
+js_arraybuffer_span_of_t(T *data, size_t len) -> js_arraybuffer_span_of_t<T>;
 
 template <typename T>
-struct js_type_info_t<js_typedarray_span_of_t<T, 1>> {
+struct js_type_info_t<js_arraybuffer_span_of_t<T, 1>> {
   using type = js_value_t *;
 
   static constexpr auto signature = js_object;
 
   template <js_type_options_t options>
   static auto
-  marshall(js_env_t *env, js_typedarray_span_of_t<T, 1> &view, js_value_t *&result) {
+  marshall(js_env_t *env, js_arraybuffer_span_of_t<T, 1> &view, js_value_t *&result) {
     int err;
 
-    js_value_t *arraybuffer;
-
     T *data;
-    err = js_create_arraybuffer(env, sizeof(T), reinterpret_cast<void **>(&data), &arraybuffer);
-    if (err < 0) return err;
-
-    err = js_create_typedarray(env, js_uint8array, sizeof(T), arraybuffer, 0, &result);
+    err = js_create_arraybuffer(env, sizeof(T), reinterpret_cast<void **>(&data), &result);
     if (err < 0) return err;
 
     *data = *view;
@@ -1903,48 +1971,40 @@ struct js_type_info_t<js_typedarray_span_of_t<T, 1>> {
 
   template <js_type_options_t options>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_typedarray_span_of_t<T, 1> &result) {
+  unmarshall(js_env_t *env, js_value_t *value, js_arraybuffer_span_of_t<T, 1> &result) {
     int err;
 
     if constexpr (options.checked) {
-      err = js_check_value<js_is_typedarray<>>(env, value, "typedarray");
+      err = js_check_value<js_is_arraybuffer>(env, value, "arraybuffer");
       if (err < 0) return err;
     }
 
     T *data;
     size_t len;
-    js_typedarray_type_t type;
-    err = js_get_typedarray_info(env, value, &type, reinterpret_cast<void **>(&data), &len, nullptr, nullptr);
+    err = js_get_arraybuffer_info(env, value, reinterpret_cast<void **>(&data), &len);
     if (err < 0) return err;
 
-    len *= js_typedarray_element_size(type);
-
     assert(len == sizeof(T));
 
-    result = js_typedarray_span_of_t<T, 1>(data);
+    result = js_arraybuffer_span_of_t<T, 1>(data);
 
     return 0;
   }
 };
 
 template <typename T>
-struct js_type_info_t<js_typedarray_span_of_t<T>> {
+struct js_type_info_t<js_arraybuffer_span_of_t<T>> {
   using type = js_value_t *;
 
   static constexpr auto signature = js_object;
 
   template <js_type_options_t options>
   static auto
-  marshall(js_env_t *env, js_typedarray_span_of_t<T> &view, js_value_t *&result) {
+  marshall(js_env_t *env, js_arraybuffer_span_of_t<T> &view, js_value_t *&result) {
     int err;
 
-    js_value_t *arraybuffer;
-
     T *data;
-    err = js_create_arraybuffer(env, view.size_bytes(), reinterpret_cast<void **>(&data), &arraybuffer);
-    if (err < 0) return err;
-
-    err = js_create_typedarray(env, js_uint8array, view.size_bytes(), arraybuffer, 0, &result);
+    err = js_create_arraybuffer(env, view.size_bytes(), reinterpret_cast<void **>(&data), &result);
     if (err < 0) return err;
 
     std::copy(view.begin(), view.end(), data);
@@ -1954,1655 +2014,4139 @@ struct js_type_info_t<js_typedarray_span_of_t<T>> {
 
   template <js_type_options_t options>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_typedarray_span_of_t<T> &result) {
+  unmarshall(js_env_t *env, js_value_t *value, js_arraybuffer_span_of_t<T> &result) {
     int err;
 
     if constexpr (options.checked) {
-      err = js_check_value<js_is_typedarray<>>(env, value, "typedarray");
+      err = js_check_value<js_is_arraybuffer>(env, value, "arraybuffer");
       if (err < 0) return err;
     }
 
     T *data;
     size_t len;
-    js_typedarray_type_t type;
-    err = js_get_typedarray_info(env, value, &type, reinterpret_cast<void **>(&data), &len, nullptr, nullptr);
-    if (err < 0) return err;
-
-    len *= js_typedarray_element_size(type);
+    err = js_get_arraybuffer_info(env, value, reinterpret_cast<void **>(&data), &len);
     if (err < 0) return err;
 
     assert(len % sizeof(T) == 0);
 
-    result = js_typedarray_span_of_t<T>(data, len / sizeof(T));
+    result = js_arraybuffer_span_of_t<T>(data, len / sizeof(T));
 
     return 0;
   }
 };
 
-template <>
-struct js_type_info_t<js_receiver_t> {
-  using type = js_value_t *;
+static inline size_t
+js_page_size() {
+#if defined(_WIN32)
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
 
-  static constexpr auto signature = js_object;
+  return info.dwPageSize;
+#else
+  return size_t(sysconf(_SC_PAGESIZE));
+#endif
+}
 
-  static auto
-  marshall(js_receiver_t &receiver, js_value_t *&result) {
-    result = static_cast<js_value_t *>(receiver);
+static inline int
+js_reserve_pages(size_t len, void *&result) {
+#if defined(_WIN32)
+  result = VirtualAlloc(nullptr, len, MEM_RESERVE, PAGE_NOACCESS);
+  if (result == nullptr) return uv_translate_sys_error(GetLastError());
+#else
+  result = mmap(nullptr, len, PROT_NONE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+  if (result == MAP_FAILED) return uv_translate_sys_error(errno);
+#endif
 
-    return 0;
+  return 0;
+}
+
+static inline int
+js_commit_pages(void *data, size_t len) {
+#if defined(_WIN32)
+  if (VirtualAlloc(data, len, MEM_COMMIT, PAGE_READWRITE) == nullptr) return uv_translate_sys_error(GetLastError());
+#else
+  if (mprotect(data, len, PROT_READ | PROT_WRITE) != 0) return uv_translate_sys_error(errno);
+#endif
+
+  return 0;
+}
+
+static inline void
+js_release_pages(void *data, size_t len) {
+#if defined(_WIN32)
+  VirtualFree(data, 0, MEM_RELEASE);
+#else
+  munmap(data, len);
+#endif
+}
+
+constexpr size_t js_growable_buffer_default_capacity = sizeof(void *) == 8 ? size_t(1) << 32 : size_t(1) << 26;
+
+struct js_growable_buffer_t {
+  js_growable_buffer_t() : state_(nullptr) {}
+
+  js_growable_buffer_t(js_growable_buffer_t &&that) : state_(that.state_) {
+    that.state_ = nullptr;
   }
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *, js_receiver_t &receiver, js_value_t *&result) {
-    return marshall(receiver, result);
+  js_growable_buffer_t(const js_growable_buffer_t &) = delete;
+
+  ~js_growable_buffer_t() {
+    reset();
   }
 
-  static auto
-  unmarshall(js_value_t *value, js_receiver_t &result) {
-    result = js_receiver_t(value);
+  void
+  operator=(js_growable_buffer_t &&that) {
+    reset();
 
-    return 0;
+    state_ = that.state_;
+
+    that.state_ = nullptr;
   }
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *, js_value_t *value, js_receiver_t &result) {
-    return unmarshall(value, result);
+  void
+  operator=(const js_growable_buffer_t &) = delete;
+
+  uint8_t &
+  operator[](size_t i) {
+    return state_->data[i];
   }
-};
 
-template <typename R, typename... A>
-struct js_type_info_t<js_function_t<R, A...>> {
-  using type = js_value_t *;
+  const uint8_t
+  operator[](size_t i) const {
+    return state_->data[i];
+  }
 
-  static constexpr auto signature = js_function;
+  uint8_t *
+  data() const {
+    return state_ ? state_->data : nullptr;
+  }
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *, js_function_t<R, A...> &function, js_value_t *&result) {
-    result = static_cast<js_value_t *>(function);
+  size_t
+  size() const {
+    return state_ ? state_->size : 0;
+  }
 
-    return 0;
+  size_t
+  capacity() const {
+    return state_ ? state_->reserved : 0;
   }
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_function_t<R, A...> &result) {
-    if constexpr (options.checked) {
-      int err;
-      err = js_check_value<js_is_function>(env, value, "function");
-      if (err < 0) return err;
-    }
+  bool
+  empty() const {
+    return size() == 0;
+  }
 
-    result = js_function_t<R, A...>(value);
+  uint8_t *
+  begin() const {
+    return data();
+  }
 
-    return 0;
+  uint8_t *
+  end() const {
+    return data() + size();
   }
-};
 
-template <typename T>
-struct js_type_info_t<js_external_t<T>> {
-  using type = js_value_t *;
+  int
+  reserve(size_t capacity = js_growable_buffer_default_capacity) {
+    if (state_) return state_->reserved >= capacity ? 0 : UV_EINVAL;
 
-  static constexpr auto signature = js_external;
+    int err;
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *, js_external_t<T> &external, js_value_t *&result) {
-    result = static_cast<js_value_t *>(external);
+    auto page_size = js_page_size();
+
+    if (capacity > SIZE_MAX - (page_size - 1)) return UV_EINVAL;
+
+    capacity = (capacity + page_size - 1) & ~(page_size - 1);
+
+    void *data;
+    err = js_reserve_pages(capacity, data);
+    if (err < 0) return err;
+
+    state_ = new state_t{static_cast<uint8_t *>(data), 0, 0, capacity, page_size, 1};
 
     return 0;
   }
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, js_external_t<T> &result) {
-    if constexpr (options.checked) {
-      int err;
-      err = js_check_value<js_is_external>(env, value, "external");
+  int
+  grow(size_t len, uint8_t *&result) {
+    int err;
+
+    if (state_ == nullptr) {
+      err = reserve();
       if (err < 0) return err;
     }
 
-    result = js_external_t<T>(value);
+    auto size = state_->size;
+
+    if (len > state_->reserved - size) return UV_ENOBUFS;
+
+    if (size + len > state_->committed) {
+      auto page_size = state_->page_size;
+
+      auto committed = std::max(state_->committed * 2, (size + len + page_size - 1) & ~(page_size - 1));
+
+      committed = std::min(committed, state_->reserved);
+
+      err = js_commit_pages(state_->data + state_->committed, committed - state_->committed);
+      if (err < 0) return err;
+
+      state_->committed = committed;
+    }
+
+    state_->size = size + len;
+
+    result = state_->data + size;
 
     return 0;
   }
-};
 
-template <typename T>
-struct js_type_info_t<T *> {
-  using type = T *;
+  int
+  append(const void *data, size_t len) {
+    int err;
 
-  static constexpr auto signature = js_external;
+    uint8_t *view;
+    err = grow(len, view);
+    if (err < 0) return err;
 
-  static auto
-  marshall(T *value, T *&result) {
-    result = value;
+    std::copy_n(static_cast<const uint8_t *>(data), len, view);
 
     return 0;
   }
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *, T *value, T *&result) {
-    return marshall(value, result);
+  template <typename T>
+  int
+  append(const std::span<T> &data) {
+    return append(data.data(), data.size_bytes());
   }
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *env, T *value, js_value_t *&result) {
-    return js_create_external(env, reinterpret_cast<void *>(value), nullptr, nullptr, &result);
-  }
+  void
+  reset() {
+    if (state_ == nullptr) return;
 
-  static auto
-  unmarshall(T *value, T *&result) {
-    result = value;
+    unref(state_);
 
-    return 0;
+    state_ = nullptr;
   }
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *, T *value, T *&result) {
-    return unmarshall(value, result);
-  }
+private:
+  struct state_t {
+    uint8_t *data;
+    size_t size;
+    size_t committed;
+    size_t reserved;
+    size_t page_size;
+    std::atomic<size_t> refs;
+  };
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, T *&result) {
-    if constexpr (options.checked) {
-      int err;
-      err = js_check_value<js_is_external>(env, value, "external");
-      if (err < 0) return err;
-    }
+  state_t *state_;
 
-    return js_get_value_external(env, value, reinterpret_cast<void **>(&result));
+  static void
+  unref(state_t *state) {
+    if (--state->refs > 0) return;
+
+    js_release_pages(state->data, state->reserved);
+
+    delete state;
   }
+
+  friend struct js_type_info_t<js_growable_buffer_t>;
 };
 
-template <typename T>
-struct js_type_info_t<std::shared_ptr<T>> {
+template <>
+struct js_type_info_t<js_growable_buffer_t> {
   using type = js_value_t *;
 
-  static constexpr auto signature = js_external;
+  static constexpr auto signature = js_object;
 
   template <js_type_options_t options>
   static auto
-  marshall(js_env_t *env, std::shared_ptr<T> &value, js_value_t *&result) {
+  marshall(js_env_t *env, const js_growable_buffer_t &buffer, js_value_t *&result) {
     int err;
 
-    auto handle = new std::shared_ptr<T>(value);
+    auto state = buffer.state_;
 
-    auto finalize = +[](js_env_t *, void *data, void *) {
-      delete reinterpret_cast<std::shared_ptr<T> *>(data);
+    if (state == nullptr || state->size == 0) {
+      return js_create_arraybuffer(env, 0, nullptr, &result);
+    }
+
+    auto finalize = +[](js_env_t *, void *, void *finalize_hint) {
+      js_growable_buffer_t::unref(reinterpret_cast<js_growable_buffer_t::state_t *>(finalize_hint));
     };
 
-    err = js_create_external(env, reinterpret_cast<void *>(handle), finalize, nullptr, &result);
-    if (err < 0) delete handle;
+    state->refs++;
+
+    err = js_create_external_arraybuffer(env, state->data, state->size, finalize, reinterpret_cast<void *>(state), &result);
+    if (err < 0) js_growable_buffer_t::unref(state);
 
     return err;
   }
+};
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, std::shared_ptr<T> &result) {
-    int err;
-
-    if constexpr (options.checked) {
-      err = js_check_value<js_is_external>(env, value, "external");
-      if (err < 0) return err;
-    }
+struct js_arraybuffer_pool_t {
+  static constexpr size_t min_size = 4096;
 
-    std::shared_ptr<T> *handle;
-    err = js_get_value_external(env, value, reinterpret_cast<void **>(&handle));
-    if (err < 0) return err;
+  static constexpr size_t max_size = 65536;
 
-    result = *handle;
+  static constexpr size_t size_classes = 5;
 
-    return 0;
+  js_arraybuffer_pool_t(size_t max_free = 64) : state_(new state_t()) {
+    state_->max_free = max_free;
   }
-};
 
-template <typename T>
-struct js_type_info_t<std::unique_ptr<T>> {
-  using type = js_value_t *;
+  js_arraybuffer_pool_t(const js_arraybuffer_pool_t &) = delete;
 
-  static constexpr auto signature = js_external;
+  ~js_arraybuffer_pool_t() {
+    state_->mutex.lock();
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *env, std::unique_ptr<T> &value, js_value_t *&result) {
-    int err;
+    state_->closed = true;
 
-    auto handle = new std::unique_ptr<T>(std::move(value));
+    state_->mutex.unlock();
 
-    auto finalize = +[](js_env_t *, void *data, void *) {
-      delete reinterpret_cast<std::unique_ptr<T> *>(data);
-    };
+    unref(state_);
+  }
 
-    err = js_create_external(env, reinterpret_cast<void *>(handle), finalize, nullptr, &result);
-    if (err < 0) delete handle;
+  void
+  operator=(const js_arraybuffer_pool_t &) = delete;
 
-    return err;
+  static size_t
+  size_class(size_t len) {
+    size_t i = 0;
+
+    for (auto size = min_size; size < len; size <<= 1) i++;
+
+    return i;
   }
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, std::unique_ptr<T> &result) {
-    int err;
+  uint64_t
+  hits() const {
+    uint64_t result = 0;
 
-    if constexpr (options.checked) {
-      err = js_check_value<js_is_external>(env, value, "external");
-      if (err < 0) return err;
-    }
+    for (size_t i = 0; i < size_classes; i++) result += hits(i);
 
-    std::unique_ptr<T> *handle;
-    err = js_get_value_external(env, value, reinterpret_cast<void **>(&handle));
-    if (err < 0) return err;
+    return result;
+  }
 
-    result = std::move(*handle);
+  uint64_t
+  hits(size_t size_class) const {
+    std::lock_guard lock(state_->mutex);
 
-    return 0;
+    return state_->classes[size_class].hits;
   }
-};
 
-template <size_t N>
-struct js_type_info_t<utf8_t[N]> {
-  using type = js_value_t *;
+  uint64_t
+  misses() const {
+    uint64_t result = 0;
 
-  static constexpr auto signature = js_string;
+    for (size_t i = 0; i < size_classes; i++) result += misses(i);
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *env, utf8_t value[N], js_value_t *&result) {
-    return js_create_string_utf8(env, value, N, &result);
+    return result;
   }
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, utf8_t result[N]) {
-    int err;
+  uint64_t
+  misses(size_t size_class) const {
+    std::lock_guard lock(state_->mutex);
 
-    if constexpr (options.checked) {
-      err = js_check_value<js_is_string>(env, value, "string");
-      if (err < 0) return err;
-    }
+    return state_->classes[size_class].misses;
+  }
 
-    size_t len;
-    err = js_get_value_string_utf8(env, value, result, N, &len);
-    if (err < 0) return err;
+  int
+  acquire(size_t len, uint8_t *&result) {
+    return acquire(state_, len, result);
+  }
 
-    assert(len == N);
+  static void
+  release(uint8_t *data) {
+    auto block = reinterpret_cast<block_t *>(data) - 1;
 
-    return 0;
-  }
-};
+    auto state = block->pool;
 
-template <size_t N>
-struct js_type_info_t<const utf8_t[N]> {
-  using type = js_value_t *;
+    auto i = block->size_class;
 
-  static constexpr auto signature = js_string;
+    {
+      std::lock_guard lock(state->mutex);
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *env, const utf8_t value[N], js_value_t *&result) {
-    return js_create_string_utf8(env, value, N, &result);
-  }
-};
+      if (i < size_classes && !state->closed && state->classes[i].free.size() < state->max_free) {
+        state->classes[i].free.push_back(block);
 
-template <>
-struct js_type_info_t<utf8_t *> {
-  using type = js_value_t *;
+        block = nullptr;
+      }
+    }
 
-  static constexpr auto signature = js_string;
+    if (block) free(block);
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *env, const utf8_t *value, js_value_t *&result) {
-    return js_create_string_utf8(env, value, size_t(-1), &result);
+    unref(state);
   }
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, utf8_t *&result) {
+  int
+  create(js_env_t *env, size_t len, uint8_t *&data, js_arraybuffer_t &result) {
     int err;
 
-    if constexpr (options.checked) {
-      err = js_check_value<js_is_string>(env, value, "string");
-      if (err < 0) return err;
-    }
-
-    size_t len;
-    err = js_get_value_string_utf8(env, value, nullptr, 0, &len);
+    uint8_t *block;
+    err = acquire(len, block);
     if (err < 0) return err;
 
-    len += 1 /* NULL */;
-    result = new utf8_t[len];
+    std::fill_n(block, len, 0);
 
-    return js_get_value_string_utf8(env, value, result, len, nullptr);
-  }
-};
+    err = wrap(env, block, len, result);
 
-template <>
-struct js_type_info_t<const utf8_t *> {
-  using type = js_value_t *;
+    if (err < 0) {
+      release(block);
 
-  static constexpr auto signature = js_string;
+      return err;
+    }
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *env, const utf8_t *value, js_value_t *&result) {
-    return js_create_string_utf8(env, value, size_t(-1), &result);
+    data = block;
+
+    return 0;
   }
-};
 
-template <size_t N>
-struct js_type_info_t<utf16_t[N]> {
-  using type = js_value_t *;
+private:
+  friend struct js_file_reader_t;
 
-  static constexpr auto signature = js_string;
+  struct state_t;
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *env, utf16_t value[N], js_value_t *&result) {
-    return js_create_string_utf16le(env, value, N, &result);
-  }
+  struct alignas(std::max_align_t) block_t {
+    state_t *pool;
+    size_t size_class;
+  };
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, utf16_t result[N]) {
-    int err;
+  struct size_class_t {
+    std::vector<block_t *> free;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+  };
 
-    if constexpr (options.checked) {
-      err = js_check_value<js_is_string>(env, value, "string");
-      if (err < 0) return err;
-    }
+  struct state_t {
+    std::mutex mutex;
+    size_class_t classes[size_classes];
+    size_t max_free = 0;
+    size_t refs = 1;
+    bool closed = false;
+  };
 
-    size_t len;
-    err = js_get_value_string_utf16le(env, value, result, N, &len);
-    if (err < 0) return err;
+  state_t *state_;
 
-    assert(len == N);
+  static int
+  wrap(js_env_t *env, uint8_t *data, size_t len, js_arraybuffer_t &result) {
+    auto finalize = +[](js_env_t *, void *data, void *) {
+      release(reinterpret_cast<uint8_t *>(data));
+    };
 
-    return 0;
+    return js_create_external_arraybuffer(env, reinterpret_cast<void *>(data), len, finalize, nullptr, static_cast<js_value_t **>(result));
   }
-};
 
-template <size_t N>
-struct js_type_info_t<const utf16_t[N]> {
-  using type = js_value_t *;
+  static state_t *
+  ref(state_t *state) {
+    std::lock_guard lock(state->mutex);
 
-  static constexpr auto signature = js_string;
+    state->refs++;
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *env, const utf16_t value[N], js_value_t *&result) {
-    return js_create_string_utf16le(env, value, N, &result);
+    return state;
   }
-};
 
-template <>
-struct js_type_info_t<utf16_t *> {
-  using type = js_value_t *;
+  static int
+  acquire(state_t *state, size_t len, uint8_t *&result) {
+    auto i = size_class(len);
 
-  static constexpr auto signature = js_string;
+    block_t *block = nullptr;
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *env, utf16_t *value, js_value_t *&result) {
-    return js_create_string_utf16le(env, value, size_t(-1), &result);
-  }
+    {
+      std::lock_guard lock(state->mutex);
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, utf16_t *&result) {
-    int err;
+      state->refs++;
 
-    if constexpr (options.checked) {
-      err = js_check_value<js_is_string>(env, value, "string");
-      if (err < 0) return err;
+      if (i < size_classes) {
+        auto &size_class = state->classes[i];
+
+        if (size_class.free.empty()) {
+          size_class.misses++;
+        } else {
+          size_class.hits++;
+
+          block = size_class.free.back();
+
+          size_class.free.pop_back();
+        }
+      }
     }
 
-    size_t len;
-    err = js_get_value_string_utf16le(env, value, nullptr, 0, &len);
-    if (err < 0) return err;
+    if (block == nullptr) {
+      auto size = i < size_classes ? min_size << i : len;
 
-    len += 1 /* NULL */;
-    result = new utf16_t[len];
+      block = static_cast<block_t *>(malloc(sizeof(block_t) + size));
 
-    return js_get_value_string_utf16le(env, value, result, len, nullptr);
+      if (block == nullptr) {
+        unref(state);
+
+        return UV_ENOMEM;
+      }
+
+      block->pool = state;
+      block->size_class = i;
+    }
+
+    result = reinterpret_cast<uint8_t *>(block + 1);
+
+    return 0;
   }
-};
 
-template <>
-struct js_type_info_t<const utf16_t *> {
-  using type = js_value_t *;
+  static void
+  unref(state_t *state) {
+    {
+      std::lock_guard lock(state->mutex);
 
-  static constexpr auto signature = js_string;
+      if (--state->refs > 0) return;
+    }
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *env, const utf16_t *value, js_value_t *&result) {
-    return js_create_string_utf16le(env, value, size_t(-1), &result);
+    for (auto &size_class : state->classes) {
+      for (auto block : size_class.free) free(block);
+    }
+
+    delete state;
   }
 };
 
-template <size_t N>
-struct js_type_info_t<char[N]> {
-  using type = js_value_t *;
+enum js_mapped_file_advice_t {
+  js_mapped_file_normal,
+  js_mapped_file_sequential,
+  js_mapped_file_random,
+  js_mapped_file_willneed,
+};
 
-  static constexpr auto signature = js_string;
+static inline size_t
+js_mapping_granularity() {
+#if defined(_WIN32)
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *env, char value[N], js_value_t *&result) {
-    return js_create_string_utf8(env, reinterpret_cast<const utf8_t *>(value), size_t(-1), &result);
-  }
+  return info.dwAllocationGranularity;
+#else
+  return js_page_size();
+#endif
+}
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, char result[N]) {
-    int err;
+struct js_mapped_file_t {
+  js_mapped_file_t() : base_(nullptr), mapped_(0), data_(nullptr), size_(0) {}
 
-    if constexpr (options.checked) {
-      err = js_check_value<js_is_string>(env, value, "string");
-      if (err < 0) return err;
-    }
+  js_mapped_file_t(js_mapped_file_t &&that) : base_(that.base_), mapped_(that.mapped_), data_(that.data_), size_(that.size_) {
+    that.base_ = nullptr;
+    that.mapped_ = 0;
+    that.data_ = nullptr;
+    that.size_ = 0;
+  }
 
-    size_t len;
-    err = js_get_value_string_utf8(env, value, reinterpret_cast<utf8_t *>(result), N, &len);
-    if (err < 0) return err;
+  js_mapped_file_t(const js_mapped_file_t &) = delete;
 
-    assert(len < N);
+  ~js_mapped_file_t() {
+    reset();
+  }
 
-    return 0;
+  js_mapped_file_t &
+  operator=(js_mapped_file_t &&that) {
+    std::swap(base_, that.base_);
+    std::swap(mapped_, that.mapped_);
+    std::swap(data_, that.data_);
+    std::swap(size_, that.size_);
+
+    return *this;
   }
-};
 
-template <size_t N>
-struct js_type_info_t<const char[N]> {
-  using type = js_value_t *;
+  void
+  operator=(const js_mapped_file_t &) = delete;
 
-  static constexpr auto signature = js_string;
+  uint8_t *
+  data() const {
+    return data_;
+  }
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *env, const char value[N], js_value_t *&result) {
-    return js_create_string_utf8(env, reinterpret_cast<const utf8_t *>(value), N - 1 /* NULL */, &result);
+  size_t
+  size() const {
+    return size_;
   }
-};
 
-template <>
-struct js_type_info_t<char *> {
-  using type = js_value_t *;
+  bool
+  empty() const {
+    return size_ == 0;
+  }
 
-  static constexpr auto signature = js_string;
+  uint8_t *
+  begin() const {
+    return data_;
+  }
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *env, char *value, js_value_t *&result) {
-    return js_create_string_utf8(env, reinterpret_cast<const utf8_t *>(value), size_t(-1), &result);
+  uint8_t *
+  end() const {
+    return data_ + size_;
   }
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, char *&result) {
+  uint8_t &
+  operator[](size_t i) const {
+    return data_[i];
+  }
+
+  int
+  open(const char *path, uint64_t offset = 0, size_t len = size_t(-1), js_mapped_file_advice_t advice = js_mapped_file_normal) {
     int err;
 
-    if constexpr (options.checked) {
-      err = js_check_value<js_is_string>(env, value, "string");
-      if (err < 0) return err;
-    }
+    reset();
 
-    size_t len;
-    err = js_get_value_string_utf8(env, value, nullptr, 0, &len);
+    uv_fs_t req;
+    err = uv_fs_open(nullptr, &req, path, UV_FS_O_RDONLY, 0, nullptr);
+    uv_fs_req_cleanup(&req);
     if (err < 0) return err;
 
-    len += 1 /* NULL */;
-    result = new char[len];
+    uv_file file = err;
 
-    return js_get_value_string_utf8(env, value, reinterpret_cast<utf8_t *>(result), len, nullptr);
-  }
-};
+    err = uv_fs_fstat(nullptr, &req, file, nullptr);
 
-template <>
-struct js_type_info_t<const char *> {
-  using type = js_value_t *;
+    if (err == 0) {
+      uint64_t size = uv_fs_get_statbuf(&req)->st_size;
 
-  static constexpr auto signature = js_string;
+      err = map(file, size, offset, len, advice);
+    }
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *env, const char *value, js_value_t *&result) {
-    return js_create_string_utf8(env, reinterpret_cast<const utf8_t *>(value), size_t(-1), &result);
+    uv_fs_req_cleanup(&req);
+
+    uv_fs_close(nullptr, &req, file, nullptr);
+    uv_fs_req_cleanup(&req);
+
+    return err;
   }
-};
 
-template <>
-struct js_type_info_t<std::string> {
-  using type = js_value_t *;
+  void
+  reset() {
+    if (base_ == nullptr) return;
 
-  static constexpr auto signature = js_string;
+#if defined(_WIN32)
+    UnmapViewOfFile(base_);
+#else
+    munmap(base_, mapped_);
+#endif
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *env, std::string &value, js_value_t *&result) {
-    return js_create_string_utf8(env, reinterpret_cast<const utf8_t *>(value.data()), value.length(), &result);
+    base_ = nullptr;
+    mapped_ = 0;
+    data_ = nullptr;
+    size_ = 0;
   }
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, std::string &result) {
-    int err;
+private:
+  void *base_;
+  size_t mapped_;
+  uint8_t *data_;
+  size_t size_;
 
-    if constexpr (options.checked) {
-      err = js_check_value<js_is_string>(env, value, "string");
-      if (err < 0) return err;
+  int
+  map(uv_file file, uint64_t size, uint64_t offset, size_t len, js_mapped_file_advice_t advice) {
+    if (offset > size) return UV_EINVAL;
+
+    if (len > size - offset) len = size - offset;
+
+    if (len == 0) return 0;
+
+    auto start = offset - offset % js_mapping_granularity();
+
+    auto mapped = size_t(offset - start) + len;
+
+    if (mapped < len) return UV_ENOMEM;
+
+#if defined(_WIN32)
+    auto mapping = CreateFileMappingW(HANDLE(uv_get_osfhandle(file)), nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+    if (mapping == nullptr) return uv_translate_sys_error(GetLastError());
+
+    auto base = MapViewOfFile(mapping, FILE_MAP_COPY, DWORD(start >> 32), DWORD(start), mapped);
+
+    auto error = GetLastError();
+
+    CloseHandle(mapping);
+
+    if (base == nullptr) return uv_translate_sys_error(error);
+
+    if (advice == js_mapped_file_willneed) {
+      WIN32_MEMORY_RANGE_ENTRY range = {base, mapped};
+
+      PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
     }
+#else
+    auto base = mmap(nullptr, mapped, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, off_t(start));
+    if (base == MAP_FAILED) return uv_translate_sys_error(errno);
 
-    size_t len;
-    err = js_get_value_string_utf8(env, value, nullptr, 0, &len);
-    if (err < 0) return err;
+    switch (advice) {
+    case js_mapped_file_normal:
+      break;
+    case js_mapped_file_sequential:
+      madvise(base, mapped, MADV_SEQUENTIAL);
+      break;
+    case js_mapped_file_random:
+      madvise(base, mapped, MADV_RANDOM);
+      break;
+    case js_mapped_file_willneed:
+      madvise(base, mapped, MADV_WILLNEED);
+      break;
+    }
+#endif
 
-    result.reserve(len + 1 /* NULL */);
-    result.resize(len);
+    base_ = base;
+    mapped_ = mapped;
+    data_ = static_cast<uint8_t *>(base) + (offset - start);
+    size_ = len;
 
-    return js_get_value_string_utf8(env, value, reinterpret_cast<utf8_t *>(result.data()), result.capacity(), nullptr);
+    return 0;
   }
 };
 
-template <typename T, size_t N>
-struct js_type_info_t<T[N]> {
+template <>
+struct js_type_info_t<js_mapped_file_t> {
   using type = js_value_t *;
 
   static constexpr auto signature = js_object;
 
   template <js_type_options_t options>
   static auto
-  marshall(js_env_t *env, T array[N], js_value_t *&result) {
+  marshall(js_env_t *env, js_mapped_file_t &file, js_value_t *&result) {
     int err;
 
-    err = js_create_array_with_length(env, N, &result);
-    assert(err == 0);
-
-    js_value_t *values[N];
+    if (file.empty()) {
+      file.reset();
 
-    for (uint32_t i = 0; i < N; i++) {
-      err = js_type_info_t<T>::template marshall<options>(env, array[i], values[i]);
-      if (err < 0) return err;
+      return js_create_arraybuffer(env, 0, nullptr, &result);
     }
 
-    return js_set_array_elements(env, result, const_cast<const js_value_t **>(values), N, 0);
-  }
+    auto handle = new js_mapped_file_t(std::move(file));
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, T result[N]) {
-    int err;
+    auto finalize = +[](js_env_t *, void *, void *finalize_hint) {
+      delete reinterpret_cast<js_mapped_file_t *>(finalize_hint);
+    };
 
-    if constexpr (options.checked) {
-      err = js_check_value<js_is_array>(env, value, "array");
-      if (err < 0) return err;
-    }
+    err = js_create_external_arraybuffer(env, handle->data(), handle->size(), finalize, reinterpret_cast<void *>(handle), &result);
+    if (err < 0) delete handle;
 
-    js_value_t *values[N];
-    uint32_t len;
-    err = js_get_array_elements(env, value, values, N, 0, &len);
-    if (err < 0) return err;
+    return err;
+  }
+};
 
-    assert(len == N);
+template <js_typedarray_element T>
+struct js_type_info_t<js_typedarray_t<T>> {
+  using type = js_value_t *;
 
-    for (uint32_t i = 0; i < N; i++) {
-      err = js_type_info_t<T>::template unmarshall<options>(env, values[i], result[i]);
+  static constexpr auto signature = js_object;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *, js_typedarray_t<T> &typedarray, js_value_t *&result) {
+    result = static_cast<js_value_t *>(typedarray);
+
+    return 0;
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, js_typedarray_t<T> &result) {
+    if constexpr (options.checked) {
+      int err;
+      err = js_check_value<js_is_typedarray<T>>(env, value, js_typedarray_info_t<T>::label);
       if (err < 0) return err;
     }
 
+    result = js_typedarray_t<T>(value);
+
     return 0;
   }
 };
 
-template <typename T, size_t N>
-struct js_type_info_t<const T[N]> {
+template <>
+struct js_type_info_t<js_typedarray_t<>> {
   using type = js_value_t *;
 
   static constexpr auto signature = js_object;
 
   template <js_type_options_t options>
   static auto
-  marshall(js_env_t *env, const T array[N], js_value_t *&result) {
-    int err;
-
-    err = js_create_array_with_length(env, N, &result);
-    assert(err == 0);
+  marshall(js_env_t *, js_typedarray_t<> &typedarray, js_value_t *&result) {
+    result = static_cast<js_value_t *>(typedarray);
 
-    js_value_t *values[N];
+    return 0;
+  }
 
-    for (uint32_t i = 0; i < N; i++) {
-      err = js_type_info_t<T>::template marshall<options>(env, array[i], values[i]);
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, js_typedarray_t<> &result) {
+    if constexpr (options.checked) {
+      int err;
+      err = js_check_value<js_is_typedarray<>>(env, value, "typedarray");
       if (err < 0) return err;
     }
 
-    return js_set_array_elements(env, result, const_cast<const js_value_t **>(values), N, 0);
+    result = js_typedarray_t<>(value);
+
+    return 0;
   }
 };
 
-template <typename T, size_t N>
-struct js_type_info_t<std::array<T, N>> {
-  using type = js_value_t *;
+static inline size_t
+js_typedarray_element_size(js_typedarray_type_t type) {
+  switch (type) {
+  case js_int8array:
+  case js_uint8array:
+  case js_uint8clampedarray:
+  default:
+    return 1;
+  case js_int16array:
+  case js_uint16array:
+  case js_float16array:
+    return 2;
+  case js_int32array:
+  case js_uint32array:
+  case js_float32array:
+    return 4;
+  case js_bigint64array:
+  case js_biguint64array:
+  case js_float64array:
+    return 8;
+  }
+}
 
-  static constexpr auto signature = js_object;
+namespace {
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *env, std::array<T, N> &array, js_value_t *&result) {
-    int err;
+template <typename T>
+static T js_typedarray_span_nil[1] = {T()};
 
-    err = js_create_array_with_length(env, N, &result);
-    assert(err == 0);
+}
 
-    js_value_t *values[N];
+template <typename T = js_typedarray_element_any>
+struct js_typedarray_span_t;
 
-    for (uint32_t i = 0; i < N; i++) {
-      err = js_type_info_t<T>::template marshall<options>(env, array[i], values[i]);
-      if (err < 0) return err;
-    }
+template <js_typedarray_element T>
+struct js_typedarray_span_t<T> {
+  js_typedarray_span_t() : data_(js_typedarray_span_nil<T>), size_(0) {}
 
-    return js_set_array_elements(env, result, const_cast<const js_value_t **>(values), N, 0);
+  js_typedarray_span_t(T *data, size_t len) : data_(len == 0 ? js_typedarray_span_nil<T> : data), size_(len) {}
+
+  T &
+  operator[](size_t i) {
+    return data_[i];
   }
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, std::array<T, N> &result) {
-    int err;
+  const T
+  operator[](size_t i) const {
+    return data_[i];
+  }
 
-    if constexpr (options.checked) {
-      err = js_check_value<js_is_array>(env, value, "array");
-      if (err < 0) return err;
-    }
+  T *
+  data() const {
+    return data_;
+  }
 
-    js_value_t *values[N];
-    uint32_t len;
-    err = js_get_array_elements(env, value, values, N, 0, &len);
-    if (err < 0) return err;
+  size_t
+  size() const {
+    return size_;
+  }
 
-    assert(len == N);
+  template <typename U>
+  size_t
+  size() const {
+    return size_ * sizeof(T) / sizeof(U);
+  }
 
-    for (uint32_t i = 0; i < N; i++) {
-      err = js_type_info_t<T>::template unmarshall<options>(env, values[i], result[i]);
-      if (err < 0) return err;
-    }
+  size_t
+  size_bytes() const {
+    return size_ * sizeof(T);
+  }
 
-    return 0;
+  bool
+  empty() const {
+    return size_ == 0;
+  }
+
+  T *
+  begin() const {
+    return data_;
+  }
+
+  T *
+  end() const {
+    return data_ + size_;
   }
+
+private:
+  T *data_;
+  size_t size_;
 };
 
-template <typename T>
-struct js_type_info_t<std::vector<T>> {
-  using type = js_value_t *;
+template <js_typedarray_element T>
+js_typedarray_span_t(T *data, size_t len) -> js_typedarray_span_t<T>;
 
-  static constexpr auto signature = js_object;
+using js_int8array_span_t = js_typedarray_span_t<int8_t>;
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *env, std::vector<T> &vector, js_value_t *&result) {
-    int err;
+using js_uint8array_span_t = js_typedarray_span_t<uint8_t>;
 
-    auto len = vector.size();
+using js_int16array_span_t = js_typedarray_span_t<int16_t>;
 
-    err = js_create_array_with_length(env, len, &result);
-    assert(err == 0);
+using js_uint16array_span_t = js_typedarray_span_t<uint16_t>;
 
-    std::vector<js_value_t *> values(len);
+using js_int32array_span_t = js_typedarray_span_t<int32_t>;
 
-    for (uint32_t i = 0; i < len; i++) {
-      err = js_type_info_t<T>::template marshall<options>(env, vector[i], values[i]);
-      if (err < 0) return err;
-    }
+using js_uint32array_span_t = js_typedarray_span_t<uint32_t>;
 
-    return js_set_array_elements(env, result, const_cast<const js_value_t **>(values.data()), len, 0);
+using js_bigint64array_span_t = js_typedarray_span_t<int64_t>;
+
+using js_biguint64array_span_t = js_typedarray_span_t<uint64_t>;
+
+using js_float32array_span_t = js_typedarray_span_t<float>;
+
+using js_float64array_span_t = js_typedarray_span_t<double>;
+
+template <>
+struct js_typedarray_span_t<js_typedarray_element_any> {
+  js_typedarray_span_t() : data_(nullptr), size_(0) {}
+
+  js_typedarray_span_t(void *data, size_t len, js_typedarray_type_t type) : data_(len == 0 ? nullptr : data), size_(len * js_typedarray_element_size(type)) {}
+
+  template <typename T>
+  js_typedarray_span_t(T *data, size_t len) : data_(len == 0 ? nullptr : data), size_(len * sizeof(T)) {}
+
+  template <typename T>
+  js_typedarray_span_t(const js_typedarray_span_t<T> &span) : data_(span.data()), size_(span.size_bytes()) {}
+
+  template <typename T = uint8_t>
+  T *
+  data() const {
+    return static_cast<T *>(data_);
   }
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, std::vector<T> &result) {
-    int err;
+  template <typename T = uint8_t>
+  size_t
+  size() const {
+    return size_ / sizeof(T);
+  }
 
-    if constexpr (options.checked) {
-      err = js_check_value<js_is_array>(env, value, "array");
-      if (err < 0) return err;
-    }
+  size_t
+  size_bytes() const {
+    return size_;
+  }
 
-    uint32_t len;
-    err = js_get_array_length(env, value, &len);
-    if (err < 0) return err;
+  bool
+  empty() const {
+    return size_ == 0;
+  }
+
+  template <typename T = uint8_t>
+  T *
+  begin() const {
+    return data<T>();
+  }
+
+  template <typename T = uint8_t>
+  T *
+  end() const {
+    return data<T>() + size<T>();
+  }
+
+private:
+  void *data_;
+  size_t size_;
+};
+
+js_typedarray_span_t(void *data, size_t len, js_typedarray_type_t type) -> js_typedarray_span_t<js_typedarray_element_any>;
+
+template <typename T>
+js_typedarray_span_t(T *data, size_t len) -> js_typedarray_span_t<js_typedarray_element_any>;
+
+template <typename T>
+struct js_type_info_t<js_typedarray_span_t<T>> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_object;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, js_typedarray_span_t<T> &view, js_value_t *&result) {
+    int err;
+
+    js_value_t *arraybuffer;
+
+    T *data;
+    err = js_create_arraybuffer(env, view.size_bytes(), reinterpret_cast<void **>(&data), &arraybuffer);
+    if (err < 0) return err;
+
+    std::copy(view.begin(), view.end(), data);
+
+    return js_create_typedarray(env, js_typedarray_info_t<T>::type, view.size(), arraybuffer, 0, &result);
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, js_typedarray_span_t<T> &result) {
+    int err;
+
+    if constexpr (options.checked) {
+      err = js_check_value<js_is_typedarray<T>>(env, value, js_typedarray_info_t<T>::label);
+      if (err < 0) return err;
+    }
+
+    T *data;
+    size_t len;
+    err = js_get_typedarray_info(env, value, nullptr, reinterpret_cast<void **>(&data), &len, nullptr, nullptr);
+    if (err < 0) return err;
+
+    result = js_typedarray_span_t(data, len);
+
+    return 0;
+  }
+};
+
+template <>
+struct js_type_info_t<js_typedarray_span_t<>> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_object;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, js_typedarray_span_t<> &view, js_value_t *&result) {
+    int err;
+
+    js_value_t *arraybuffer;
+
+    void *data;
+    err = js_create_arraybuffer(env, view.size_bytes(), &data, &arraybuffer);
+    if (err < 0) return err;
+
+    std::copy(view.begin(), view.end(), static_cast<uint8_t *>(data));
+
+    return js_create_typedarray(env, js_uint8array, view.size_bytes(), arraybuffer, 0, &result);
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, js_typedarray_span_t<> &result) {
+    int err;
+
+    if constexpr (options.checked) {
+      err = js_check_value<js_is_typedarray<>>(env, value, "typedarray");
+      if (err < 0) return err;
+    }
+
+    void *data;
+    size_t len;
+    js_typedarray_type_t type;
+    err = js_get_typedarray_info(env, value, &type, &data, &len, nullptr, nullptr);
+    if (err < 0) return err;
+
+    result = js_typedarray_span_t(data, len, type);
+
+    return 0;
+  }
+};
+
+constexpr auto js_typedarray_span_dynamic = size_t(-1);
+
+template <typename T, size_t N = js_typedarray_span_dynamic>
+struct js_typedarray_span_of_t;
+
+template <typename T>
+struct js_typedarray_span_of_t<T, 1> {
+  js_typedarray_span_of_t() : data_(nullptr) {}
+
+  js_typedarray_span_of_t(T *data) : data_(data) {}
+
+  operator T *() const {
+    return data_;
+  }
+
+  T *
+  operator->() const {
+    return data_;
+  }
+
+  T &
+  operator*() {
+    return *data_;
+  }
+
+  const T &
+  operator*() const {
+    return *data_;
+  }
+
+private:
+  T *data_;
+};
+
+template <typename T>
+js_typedarray_span_of_t(T *data) -> js_typedarray_span_of_t<T, 1>;
+
+template <typename T>
+struct js_typedarray_span_of_t<T, js_typedarray_span_dynamic> {
+  js_typedarray_span_of_t() : data_(js_typedarray_span_nil<T>), size_(0) {}
+
+  js_typedarray_span_of_t(T *data, size_t len) : data_(len == 0 ? js_typedarray_span_nil<T> : data), size_(len) {}
+
+  T &
+  operator[](size_t i) {
+    return data_[i];
+  }
+
+  const T
+  operator[](size_t i) const {
+    return data_[i];
+  }
+
+  T *
+  data() const {
+    return data_;
+  }
+
+  size_t
+  size() const {
+    return size_;
+  }
+
+  size_t
+  size_bytes() const {
+    return size_ * sizeof(T);
+  }
+
+  bool
+  empty() const {
+    return size_ == 0;
+  }
+
+  T *
+  begin() const {
+    return data_;
+  }
+
+  T *
+  end() const {
+    return data_ + size_;
+  }
+
+private:
+  T *data_;
+  size_t size_;
+};
+
+template <typename T>
+js_typedarray_span_of_t(T *data, size_t len) -> js_typedarray_span_of_t<T>;
+
+template <typename T>
+struct js_type_info_t<js_typedarray_span_of_t<T, 1>> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_object;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, js_typedarray_span_of_t<T, 1> &view, js_value_t *&result) {
+    int err;
+
+    js_value_t *arraybuffer;
+
+    T *data;
+    err = js_create_arraybuffer(env, sizeof(T), reinterpret_cast<void **>(&data), &arraybuffer);
+    if (err < 0) return err;
+
+    err = js_create_typedarray(env, js_uint8array, sizeof(T), arraybuffer, 0, &result);
+    if (err < 0) return err;
+
+    *data = *view;
+
+    return 0;
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, js_typedarray_span_of_t<T, 1> &result) {
+    int err;
+
+    if constexpr (options.checked) {
+      err = js_check_value<js_is_typedarray<>>(env, value, "typedarray");
+      if (err < 0) return err;
+    }
+
+    T *data;
+    size_t len;
+    js_typedarray_type_t type;
+    err = js_get_typedarray_info(env, value, &type, reinterpret_cast<void **>(&data), &len, nullptr, nullptr);
+    if (err < 0) return err;
+
+    len *= js_typedarray_element_size(type);
+
+    assert(len == sizeof(T));
+
+    result = js_typedarray_span_of_t<T, 1>(data);
+
+    return 0;
+  }
+};
+
+template <typename T>
+struct js_type_info_t<js_typedarray_span_of_t<T>> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_object;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, js_typedarray_span_of_t<T> &view, js_value_t *&result) {
+    int err;
+
+    js_value_t *arraybuffer;
+
+    T *data;
+    err = js_create_arraybuffer(env, view.size_bytes(), reinterpret_cast<void **>(&data), &arraybuffer);
+    if (err < 0) return err;
+
+    err = js_create_typedarray(env, js_uint8array, view.size_bytes(), arraybuffer, 0, &result);
+    if (err < 0) return err;
+
+    std::copy(view.begin(), view.end(), data);
+
+    return 0;
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, js_typedarray_span_of_t<T> &result) {
+    int err;
+
+    if constexpr (options.checked) {
+      err = js_check_value<js_is_typedarray<>>(env, value, "typedarray");
+      if (err < 0) return err;
+    }
+
+    T *data;
+    size_t len;
+    js_typedarray_type_t type;
+    err = js_get_typedarray_info(env, value, &type, reinterpret_cast<void **>(&data), &len, nullptr, nullptr);
+    if (err < 0) return err;
+
+    len *= js_typedarray_element_size(type);
+    if (err < 0) return err;
+
+    assert(len % sizeof(T) == 0);
+
+    result = js_typedarray_span_of_t<T>(data, len / sizeof(T));
+
+    return 0;
+  }
+};
+
+template <>
+struct js_type_info_t<js_receiver_t> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_object;
+
+  static auto
+  marshall(js_receiver_t &receiver, js_value_t *&result) {
+    result = static_cast<js_value_t *>(receiver);
+
+    return 0;
+  }
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *, js_receiver_t &receiver, js_value_t *&result) {
+    return marshall(receiver, result);
+  }
+
+  static auto
+  unmarshall(js_value_t *value, js_receiver_t &result) {
+    result = js_receiver_t(value);
+
+    return 0;
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *, js_value_t *value, js_receiver_t &result) {
+    return unmarshall(value, result);
+  }
+};
+
+template <typename R, typename... A>
+struct js_type_info_t<js_function_t<R, A...>> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_function;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *, js_function_t<R, A...> &function, js_value_t *&result) {
+    result = static_cast<js_value_t *>(function);
+
+    return 0;
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, js_function_t<R, A...> &result) {
+    if constexpr (options.checked) {
+      int err;
+      err = js_check_value<js_is_function>(env, value, "function");
+      if (err < 0) return err;
+    }
+
+    result = js_function_t<R, A...>(value);
+
+    return 0;
+  }
+};
+
+template <typename T>
+struct js_type_info_t<js_external_t<T>> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_external;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *, js_external_t<T> &external, js_value_t *&result) {
+    result = static_cast<js_value_t *>(external);
+
+    return 0;
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, js_external_t<T> &result) {
+    if constexpr (options.checked) {
+      int err;
+      err = js_check_value<js_is_external>(env, value, "external");
+      if (err < 0) return err;
+    }
+
+    result = js_external_t<T>(value);
+
+    return 0;
+  }
+};
+
+template <typename T>
+struct js_type_info_t<T *> {
+  static constexpr bool identity = js_preserve_identity<std::remove_cv_t<T>>;
+
+  using type = std::conditional_t<identity, js_value_t *, T *>;
+
+  static constexpr auto signature = js_external;
+
+  static auto
+  marshall(T *value, T *&result)
+    requires(!identity)
+  {
+    result = value;
+
+    return 0;
+  }
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *, T *value, T *&result)
+    requires(!identity)
+  {
+    return marshall(value, result);
+  }
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, T *value, js_value_t *&result) {
+    if constexpr (identity) {
+      return js_external_cache_t::get(env, reinterpret_cast<void *>(value), result);
+    } else {
+      return js_create_external(env, reinterpret_cast<void *>(value), nullptr, nullptr, &result);
+    }
+  }
+
+  static auto
+  unmarshall(T *value, T *&result)
+    requires(!identity)
+  {
+    result = value;
+
+    return 0;
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *, T *value, T *&result)
+    requires(!identity)
+  {
+    return unmarshall(value, result);
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, T *&result) {
+    if constexpr (options.checked) {
+      int err;
+      err = js_check_value<js_is_external>(env, value, "external");
+      if (err < 0) return err;
+    }
+
+    return js_get_value_external(env, value, reinterpret_cast<void **>(&result));
+  }
+};
+
+template <typename T>
+struct js_type_info_t<std::shared_ptr<T>> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_external;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, std::shared_ptr<T> &value, js_value_t *&result) {
+    int err;
+
+    auto handle = new std::shared_ptr<T>(value);
+
+    auto finalize = +[](js_env_t *, void *data, void *) {
+      delete reinterpret_cast<std::shared_ptr<T> *>(data);
+    };
+
+    err = js_create_external(env, reinterpret_cast<void *>(handle), finalize, nullptr, &result);
+    if (err < 0) delete handle;
+
+    return err;
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, std::shared_ptr<T> &result) {
+    int err;
+
+    if constexpr (options.checked) {
+      err = js_check_value<js_is_external>(env, value, "external");
+      if (err < 0) return err;
+    }
+
+    std::shared_ptr<T> *handle;
+    err = js_get_value_external(env, value, reinterpret_cast<void **>(&handle));
+    if (err < 0) return err;
+
+    result = *handle;
+
+    return 0;
+  }
+};
+
+template <typename T>
+struct js_type_info_t<std::unique_ptr<T>> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_external;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, std::unique_ptr<T> &value, js_value_t *&result) {
+    int err;
+
+    auto handle = new std::unique_ptr<T>(std::move(value));
+
+    auto finalize = +[](js_env_t *, void *data, void *) {
+      delete reinterpret_cast<std::unique_ptr<T> *>(data);
+    };
+
+    err = js_create_external(env, reinterpret_cast<void *>(handle), finalize, nullptr, &result);
+    if (err < 0) delete handle;
+
+    return err;
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, std::unique_ptr<T> &result) {
+    int err;
+
+    if constexpr (options.checked) {
+      err = js_check_value<js_is_external>(env, value, "external");
+      if (err < 0) return err;
+    }
+
+    std::unique_ptr<T> *handle;
+    err = js_get_value_external(env, value, reinterpret_cast<void **>(&handle));
+    if (err < 0) return err;
+
+    result = std::move(*handle);
+
+    return 0;
+  }
+};
+
+template <size_t N>
+struct js_type_info_t<utf8_t[N]> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_string;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, utf8_t value[N], js_value_t *&result) {
+    return js_create_string_utf8(env, value, N, &result);
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, utf8_t result[N]) {
+    int err;
+
+    if constexpr (options.checked) {
+      err = js_check_value<js_is_string>(env, value, "string");
+      if (err < 0) return err;
+    }
+
+    size_t len;
+    err = js_get_value_string_utf8(env, value, result, N, &len);
+    if (err < 0) return err;
+
+    assert(len == N);
+
+    return 0;
+  }
+};
+
+template <size_t N>
+struct js_type_info_t<const utf8_t[N]> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_string;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, const utf8_t value[N], js_value_t *&result) {
+    return js_create_string_utf8(env, value, N, &result);
+  }
+};
+
+template <>
+struct js_type_info_t<utf8_t *> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_string;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, const utf8_t *value, js_value_t *&result) {
+    return js_create_string_utf8(env, value, size_t(-1), &result);
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, utf8_t *&result) {
+    int err;
+
+    if constexpr (options.checked) {
+      err = js_check_value<js_is_string>(env, value, "string");
+      if (err < 0) return err;
+    }
+
+    size_t len;
+    err = js_get_value_string_utf8(env, value, nullptr, 0, &len);
+    if (err < 0) return err;
+
+    len += 1 /* NULL */;
+    result = new utf8_t[len];
+
+    return js_get_value_string_utf8(env, value, result, len, nullptr);
+  }
+};
+
+template <>
+struct js_type_info_t<const utf8_t *> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_string;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, const utf8_t *value, js_value_t *&result) {
+    return js_create_string_utf8(env, value, size_t(-1), &result);
+  }
+};
+
+template <size_t N>
+struct js_type_info_t<utf16_t[N]> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_string;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, utf16_t value[N], js_value_t *&result) {
+    return js_create_string_utf16le(env, value, N, &result);
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, utf16_t result[N]) {
+    int err;
+
+    if constexpr (options.checked) {
+      err = js_check_value<js_is_string>(env, value, "string");
+      if (err < 0) return err;
+    }
+
+    size_t len;
+    err = js_get_value_string_utf16le(env, value, result, N, &len);
+    if (err < 0) return err;
+
+    assert(len == N);
+
+    return 0;
+  }
+};
+
+template <size_t N>
+struct js_type_info_t<const utf16_t[N]> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_string;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, const utf16_t value[N], js_value_t *&result) {
+    return js_create_string_utf16le(env, value, N, &result);
+  }
+};
+
+template <>
+struct js_type_info_t<utf16_t *> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_string;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, utf16_t *value, js_value_t *&result) {
+    return js_create_string_utf16le(env, value, size_t(-1), &result);
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, utf16_t *&result) {
+    int err;
+
+    if constexpr (options.checked) {
+      err = js_check_value<js_is_string>(env, value, "string");
+      if (err < 0) return err;
+    }
+
+    size_t len;
+    err = js_get_value_string_utf16le(env, value, nullptr, 0, &len);
+    if (err < 0) return err;
+
+    len += 1 /* NULL */;
+    result = new utf16_t[len];
+
+    return js_get_value_string_utf16le(env, value, result, len, nullptr);
+  }
+};
+
+template <>
+struct js_type_info_t<const utf16_t *> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_string;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, const utf16_t *value, js_value_t *&result) {
+    return js_create_string_utf16le(env, value, size_t(-1), &result);
+  }
+};
+
+template <size_t N>
+struct js_type_info_t<char[N]> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_string;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, char value[N], js_value_t *&result) {
+    return js_create_string_utf8(env, reinterpret_cast<const utf8_t *>(value), size_t(-1), &result);
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, char result[N]) {
+    int err;
+
+    if constexpr (options.checked) {
+      err = js_check_value<js_is_string>(env, value, "string");
+      if (err < 0) return err;
+    }
+
+    size_t len;
+    err = js_get_value_string_utf8(env, value, reinterpret_cast<utf8_t *>(result), N, &len);
+    if (err < 0) return err;
+
+    assert(len < N);
+
+    return 0;
+  }
+};
+
+template <size_t N>
+struct js_type_info_t<const char[N]> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_string;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, const char value[N], js_value_t *&result) {
+    return js_create_string_utf8(env, reinterpret_cast<const utf8_t *>(value), N - 1 /* NULL */, &result);
+  }
+};
+
+template <>
+struct js_type_info_t<char *> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_string;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, char *value, js_value_t *&result) {
+    return js_create_string_utf8(env, reinterpret_cast<const utf8_t *>(value), size_t(-1), &result);
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, char *&result) {
+    int err;
+
+    if constexpr (options.checked) {
+      err = js_check_value<js_is_string>(env, value, "string");
+      if (err < 0) return err;
+    }
+
+    size_t len;
+    err = js_get_value_string_utf8(env, value, nullptr, 0, &len);
+    if (err < 0) return err;
+
+    len += 1 /* NULL */;
+    result = new char[len];
+
+    return js_get_value_string_utf8(env, value, reinterpret_cast<utf8_t *>(result), len, nullptr);
+  }
+};
+
+template <>
+struct js_type_info_t<const char *> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_string;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, const char *value, js_value_t *&result) {
+    return js_create_string_utf8(env, reinterpret_cast<const utf8_t *>(value), size_t(-1), &result);
+  }
+};
+
+template <>
+struct js_type_info_t<std::string> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_string;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, std::string &value, js_value_t *&result) {
+    return js_create_string_utf8(env, reinterpret_cast<const utf8_t *>(value.data()), value.length(), &result);
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, std::string &result) {
+    int err;
+
+    if constexpr (options.checked) {
+      err = js_check_value<js_is_string>(env, value, "string");
+      if (err < 0) return err;
+    }
+
+    size_t len;
+    err = js_get_value_string_utf8(env, value, nullptr, 0, &len);
+    if (err < 0) return err;
+
+    result.reserve(len + 1 /* NULL */);
+    result.resize(len);
+
+    return js_get_value_string_utf8(env, value, reinterpret_cast<utf8_t *>(result.data()), result.capacity(), nullptr);
+  }
+};
+
+template <typename T, size_t N>
+struct js_type_info_t<T[N]> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_object;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, T array[N], js_value_t *&result) {
+    int err;
+
+    err = js_create_array_with_length(env, N, &result);
+    assert(err == 0);
+
+    js_value_t *values[N];
+
+    for (uint32_t i = 0; i < N; i++) {
+      err = js_type_info_t<T>::template marshall<options>(env, array[i], values[i]);
+      if (err < 0) return err;
+    }
+
+    return js_set_array_elements(env, result, const_cast<const js_value_t **>(values), N, 0);
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, T result[N]) {
+    int err;
+
+    if constexpr (options.checked) {
+      err = js_check_value<js_is_array>(env, value, "array");
+      if (err < 0) return err;
+    }
+
+    js_value_t *values[N];
+    uint32_t len;
+    err = js_get_array_elements(env, value, values, N, 0, &len);
+    if (err < 0) return err;
+
+    assert(len == N);
+
+    for (uint32_t i = 0; i < N; i++) {
+      err = js_type_info_t<T>::template unmarshall<options>(env, values[i], result[i]);
+      if (err < 0) return err;
+    }
+
+    return 0;
+  }
+};
+
+template <typename T, size_t N>
+struct js_type_info_t<const T[N]> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_object;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, const T array[N], js_value_t *&result) {
+    int err;
+
+    err = js_create_array_with_length(env, N, &result);
+    assert(err == 0);
+
+    js_value_t *values[N];
+
+    for (uint32_t i = 0; i < N; i++) {
+      err = js_type_info_t<T>::template marshall<options>(env, array[i], values[i]);
+      if (err < 0) return err;
+    }
+
+    return js_set_array_elements(env, result, const_cast<const js_value_t **>(values), N, 0);
+  }
+};
+
+template <typename T, size_t N>
+struct js_type_info_t<std::array<T, N>> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_object;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, std::array<T, N> &array, js_value_t *&result) {
+    int err;
+
+    err = js_create_array_with_length(env, N, &result);
+    assert(err == 0);
+
+    js_value_t *values[N];
+
+    for (uint32_t i = 0; i < N; i++) {
+      err = js_type_info_t<T>::template marshall<options>(env, array[i], values[i]);
+      if (err < 0) return err;
+    }
+
+    return js_set_array_elements(env, result, const_cast<const js_value_t **>(values), N, 0);
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, std::array<T, N> &result) {
+    int err;
+
+    if constexpr (options.checked) {
+      err = js_check_value<js_is_array>(env, value, "array");
+      if (err < 0) return err;
+    }
+
+    js_value_t *values[N];
+    uint32_t len;
+    err = js_get_array_elements(env, value, values, N, 0, &len);
+    if (err < 0) return err;
+
+    assert(len == N);
+
+    for (uint32_t i = 0; i < N; i++) {
+      err = js_type_info_t<T>::template unmarshall<options>(env, values[i], result[i]);
+      if (err < 0) return err;
+    }
+
+    return 0;
+  }
+};
+
+template <typename T>
+struct js_type_info_t<std::vector<T>> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_object;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, std::vector<T> &vector, js_value_t *&result) {
+    int err;
+
+    auto len = vector.size();
+
+    err = js_create_array_with_length(env, len, &result);
+    assert(err == 0);
+
+    std::vector<js_value_t *> values(len);
+
+    for (uint32_t i = 0; i < len; i++) {
+      err = js_type_info_t<T>::template marshall<options>(env, vector[i], values[i]);
+      if (err < 0) return err;
+    }
+
+    return js_set_array_elements(env, result, const_cast<const js_value_t **>(values.data()), len, 0);
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, std::vector<T> &result) {
+    int err;
+
+    if constexpr (options.checked) {
+      err = js_check_value<js_is_array>(env, value, "array");
+      if (err < 0) return err;
+    }
+
+    uint32_t len;
+    err = js_get_array_length(env, value, &len);
+    if (err < 0) return err;
+
+    std::vector<js_value_t *> values(len);
+    err = js_get_array_elements(env, value, values.data(), len, 0, &len);
+    if (err < 0) return err;
+
+    result.resize(len);
+
+    for (uint32_t i = 0; i < len; i++) {
+      err = js_type_info_t<T>::template unmarshall<options>(env, values[i], result[i]);
+      if (err < 0) return err;
+    }
+
+    return 0;
+  }
+};
+
+template <typename R>
+constexpr bool js_is_array_range = std::ranges::view<R>;
+
+template <typename C, typename Traits>
+constexpr bool js_is_array_range<std::basic_string_view<C, Traits>> = false;
+
+template <typename R>
+  requires std::ranges::input_range<R> && js_is_array_range<R>
+struct js_type_info_t<R> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_object;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, R &range, js_value_t *&result) {
+    using T = std::ranges::range_value_t<R>;
+
+    constexpr uint32_t chunk = 64;
+
+    int err;
+
+    if constexpr (std::ranges::sized_range<R>) {
+      err = js_create_array_with_length(env, std::ranges::size(range), &result);
+    } else {
+      err = js_create_array(env, &result);
+    }
+
+    if (err < 0) return err;
+
+    auto it = std::ranges::begin(range);
+    auto end = std::ranges::end(range);
+
+    uint32_t offset = 0;
+
+    while (it != end) {
+      js_scope_t scope(env);
+
+      js_value_t *values[chunk];
+
+      uint32_t len = 0;
+
+      for (; len < chunk && it != end; ++it, ++len) {
+        T value = *it;
+
+        err = js_type_info_t<T>::template marshall<options>(env, value, values[len]);
+        if (err < 0) return err;
+      }
+
+      err = js_set_array_elements(env, result, const_cast<const js_value_t **>(values), len, offset);
+      if (err < 0) return err;
+
+      offset += len;
+    }
+
+    return 0;
+  }
+};
+
+template <typename T>
+struct js_generator_t {
+  struct promise_type {
+    js_generator_t
+    get_return_object() {
+      return js_generator_t(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+
+    std::suspend_always
+    initial_suspend() noexcept {
+      return {};
+    }
+
+    std::suspend_always
+    final_suspend() noexcept {
+      return {};
+    }
+
+    std::suspend_always
+    yield_value(T value) {
+      value_ = std::move(value);
+
+      return {};
+    }
+
+    void
+    return_void() {}
+
+    void
+    unhandled_exception() {
+      throw;
+    }
+
+  private:
+    friend js_generator_t;
+
+    std::optional<T> value_;
+  };
+
+  struct iterator {
+    using iterator_category = std::input_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+
+    iterator() : handle_(nullptr) {}
+
+    iterator(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+    T &
+    operator*() const {
+      return *handle_.promise().value_;
+    }
+
+    iterator &
+    operator++() {
+      handle_.resume();
+
+      return *this;
+    }
+
+    void
+    operator++(int) {
+      ++*this;
+    }
+
+    bool
+    operator==(std::default_sentinel_t) const {
+      return handle_ == nullptr || handle_.done();
+    }
+
+  private:
+    std::coroutine_handle<promise_type> handle_;
+  };
+
+  js_generator_t(js_generator_t &&that) : handle_(std::exchange(that.handle_, nullptr)) {}
+
+  js_generator_t(const js_generator_t &) = delete;
+
+  ~js_generator_t() {
+    if (handle_) handle_.destroy();
+  }
+
+  void
+  operator=(js_generator_t &&that) {
+    if (handle_) handle_.destroy();
+
+    handle_ = std::exchange(that.handle_, nullptr);
+  }
+
+  void
+  operator=(const js_generator_t &) = delete;
+
+  iterator
+  begin() {
+    if (handle_) handle_.resume();
+
+    return iterator(handle_);
+  }
+
+  std::default_sentinel_t
+  end() {
+    return {};
+  }
+
+private:
+  js_generator_t(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+  std::coroutine_handle<promise_type> handle_;
+};
+
+template <typename T>
+constexpr bool js_is_array_range<js_generator_t<T>> = true;
+
+template <typename T, js_type_options_t options = js_type_options_t(), uint32_t chunk = 64>
+struct js_array_view_t {
+  struct iterator {
+    using iterator_category = std::input_iterator_tag;
+    using value_type = T;
+    using difference_type = std::ptrdiff_t;
+    using pointer = void;
+    using reference = T;
+
+    iterator() : view_(nullptr), i_(0) {}
+
+    iterator(js_array_view_t *view, uint32_t i) : view_(view), i_(i) {}
+
+    T
+    operator*() const {
+      return (*view_)[i_];
+    }
+
+    iterator &
+    operator++() {
+      i_++;
+
+      return *this;
+    }
+
+    iterator
+    operator++(int) {
+      auto result = *this;
+
+      i_++;
+
+      return result;
+    }
+
+    bool
+    operator==(const iterator &that) const {
+      return i_ == that.i_;
+    }
+
+    uint32_t
+    index() const {
+      return i_;
+    }
+
+  private:
+    js_array_view_t *view_;
+    uint32_t i_;
+  };
+
+  js_array_view_t() : env_(nullptr), array_(nullptr), len_(0), offset_(0), count_(0) {}
+
+  js_array_view_t(js_env_t *env, js_value_t *array, uint32_t len) : env_(env), array_(array), len_(len), offset_(0), count_(0) {}
+
+  explicit operator js_value_t *() const {
+    return array_;
+  }
+
+  uint32_t
+  size() const {
+    return len_;
+  }
+
+  bool
+  empty() const {
+    return len_ == 0;
+  }
+
+  iterator
+  begin() {
+    return iterator(this, 0);
+  }
+
+  iterator
+  end() {
+    return iterator(this, len_);
+  }
+
+  T
+  operator[](uint32_t i) {
+    int err;
+
+    assert(i < len_);
+
+    if (i < offset_ || i >= offset_ + count_) {
+      offset_ = i - i % chunk;
+
+      err = js_get_array_elements(env_, array_, elements_, chunk, offset_, &count_);
+      if (err < 0) throw err;
+    }
+
+    js_value_t *element;
+
+    if (i < offset_ + count_) {
+      element = elements_[i - offset_];
+    } else {
+      err = js_get_undefined(env_, &element);
+      if (err < 0) throw err;
+    }
+
+    T result;
+    err = js_type_info_t<T>::template unmarshall<options>(env_, element, result);
+    if (err < 0) throw err;
+
+    return result;
+  }
+
+private:
+  js_env_t *env_;
+  js_value_t *array_;
+  uint32_t len_;
+  uint32_t offset_;
+  uint32_t count_;
+  js_value_t *elements_[chunk];
+};
+
+template <typename T, js_type_options_t view_options, uint32_t chunk>
+struct js_type_info_t<js_array_view_t<T, view_options, chunk>> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_object;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *, const js_array_view_t<T, view_options, chunk> &view, js_value_t *&result) {
+    result = static_cast<js_value_t *>(view);
+
+    return 0;
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, js_array_view_t<T, view_options, chunk> &result) {
+    int err;
+
+    if constexpr (options.checked) {
+      err = js_check_value<js_is_array>(env, value, "array");
+      if (err < 0) return err;
+    }
+
+    uint32_t len;
+    err = js_get_array_length(env, value, &len);
+    if (err < 0) return err;
+
+    result = js_array_view_t<T, view_options, chunk>(env, value, len);
+
+    return 0;
+  }
+};
+
+template <typename... T>
+struct js_type_info_t<std::tuple<T...>> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_object;
+
+  template <js_type_options_t options, size_t... I>
+  static auto
+  marshall(js_env_t *env, std::tuple<T...> &tuple, js_value_t *&result, std::index_sequence<I...>) {
+    int err;
+    err = js_create_array_with_length(env, sizeof...(T), &result);
+    assert(err == 0);
+
+    try {
+      js_value_t *values[] = {
+        js_marshall_untyped_value<options, T>(env, std::get<I>(tuple))...
+      };
+
+      return js_set_array_elements(env, result, const_cast<const js_value_t **>(values), sizeof...(T), 0);
+    } catch (int err) {
+      return err;
+    }
+  }
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, std::tuple<T...> &tuple, js_value_t *&result) {
+    return marshall<options>(env, tuple, result, std::index_sequence_for<T...>());
+  }
+
+  template <js_type_options_t options, size_t... I>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, std::tuple<T...> &result, std::index_sequence<I...>) {
+    int err;
+
+    if constexpr (options.checked) {
+      err = js_check_value<js_is_array>(env, value, "array");
+      if (err < 0) return err;
+    }
+
+    js_value_t *values[sizeof...(T)];
+    uint32_t len;
+    err = js_get_array_elements(env, value, values, sizeof...(T), 0, &len);
+    if (err < 0) return err;
+
+    assert(len == sizeof...(T));
+
+    try {
+      result = {
+        js_unmarshall_untyped_value<options, T>(env, values[I])...
+      };
+
+      return 0;
+    } catch (int err) {
+      return err;
+    }
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, std::tuple<T...> &result) {
+    return unmarshall<options>(env, value, result, std::index_sequence_for<T...>());
+  }
+};
+
+template <typename M, typename V>
+struct js_object_map_info_t {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_object;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, M &map, js_value_t *&result) {
+    int err;
+    err = js_create_object(env, &result);
+    if (err < 0) return err;
+
+    auto len = map.size();
+
+    if (len == 0) return 0;
+
+    std::vector<js_property_descriptor_t> descriptors(len);
+
+    size_t i = 0;
+
+    for (auto &[key, value] : map) {
+      auto &descriptor = descriptors[i++];
+
+      descriptor.version = 0;
+      descriptor.data = nullptr;
+      descriptor.attributes = js_writable | js_enumerable | js_configurable;
+      descriptor.method = nullptr;
+      descriptor.getter = nullptr;
+      descriptor.setter = nullptr;
+
+      err = js_create_property_key_utf8(env, reinterpret_cast<const utf8_t *>(key.data()), key.length(), &descriptor.name);
+      if (err < 0) return err;
+
+      err = js_type_info_t<V>::template marshall<options>(env, value, descriptor.value);
+      if (err < 0) return err;
+    }
+
+    return js_define_properties(env, result, descriptors.data(), len);
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, M &result) {
+    int err;
+
+    if constexpr (options.checked) {
+      err = js_check_value<js_is_object>(env, value, "object");
+      if (err < 0) return err;
+    }
+
+    js_value_t *names;
+    err = js_get_filtered_property_names(env, value, js_key_own_only, js_key_filter_t(js_key_enumerable | js_key_skip_symbols), js_key_convert_to_string, &names);
+    if (err < 0) return err;
+
+    uint32_t len;
+    err = js_get_array_length(env, names, &len);
+    if (err < 0) return err;
+
+    std::vector<js_value_t *> keys(len);
+    err = js_get_array_elements(env, names, keys.data(), len, 0, &len);
+    if (err < 0) return err;
+
+    constexpr auto flat = js_is_same<M, std::vector<std::pair<std::string, V>>>;
+
+    result.clear();
+
+    if constexpr (requires { result.reserve(len); }) result.reserve(len);
+
+    for (uint32_t i = 0; i < len; i++) {
+      std::string key;
+      err = js_type_info_t<std::string>::template unmarshall<options>(env, keys[i], key);
+      if (err < 0) return err;
+
+      js_value_t *property;
+      err = js_get_property(env, value, keys[i], &property);
+      if (err < 0) return err;
+
+      V unmarshalled;
+      err = js_type_info_t<V>::template unmarshall<options>(env, property, unmarshalled);
+      if (err < 0) return err;
+
+      if constexpr (flat) {
+        result.emplace_back(std::move(key), std::move(unmarshalled));
+      } else {
+        result.emplace(std::move(key), std::move(unmarshalled));
+      }
+    }
+
+    if constexpr (flat) {
+      std::sort(result.begin(), result.end(), [](const auto &a, const auto &b) { return a.first < b.first; });
+    }
+
+    return 0;
+  }
+};
+
+template <typename V>
+struct js_type_info_t<std::map<std::string, V>> : js_object_map_info_t<std::map<std::string, V>, V> {};
+
+template <typename V>
+struct js_type_info_t<std::unordered_map<std::string, V>> : js_object_map_info_t<std::unordered_map<std::string, V>, V> {};
+
+template <typename V>
+struct js_type_info_t<std::vector<std::pair<std::string, V>>> : js_object_map_info_t<std::vector<std::pair<std::string, V>>, V> {};
+
+template <typename T>
+struct js_type_info_t<std::span<T>> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_object;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, std::span<T> &view, js_value_t *&result) {
+    int err;
+
+    js_value_t *arraybuffer;
+
+    T *data;
+    err = js_create_arraybuffer(env, view.size_bytes(), reinterpret_cast<void **>(&data), &arraybuffer);
+    if (err < 0) return err;
+
+    std::copy(view.begin(), view.end(), data);
+
+    return js_create_typedarray(env, js_typedarray_info_t<T>::type, view.size(), arraybuffer, 0, &result);
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, std::span<T> &result) {
+    int err;
+
+    if constexpr (options.checked) {
+      err = js_check_value<js_is_typedarray<T>>(env, value, js_typedarray_info_t<T>::label);
+      if (err < 0) return err;
+    }
+
+    T *data;
+    size_t len;
+    err = js_get_typedarray_info(env, value, nullptr, reinterpret_cast<void **>(&data), &len, nullptr, nullptr);
+    if (err < 0) return err;
+
+    result = std::span(data, len);
+
+    return 0;
+  }
+};
+
+template <typename T>
+struct js_type_info_t<std::span<const T>> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_object;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, const std::span<const T> &view, js_value_t *&result) {
+    int err;
+
+    js_value_t *arraybuffer;
+
+    T *data;
+    err = js_create_arraybuffer(env, view.size_bytes(), reinterpret_cast<void **>(&data), &arraybuffer);
+    if (err < 0) return err;
+
+    std::copy(view.begin(), view.end(), data);
+
+    return js_create_typedarray(env, js_typedarray_info_t<T>::type, view.size(), arraybuffer, 0, &result);
+  }
+};
+
+template <typename T>
+struct js_type_info_t<std::optional<T>> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_type_info_t<T>::signature;
+
+  template <js_type_options_t options>
+  static auto
+  marshall(js_env_t *env, std::optional<T> &value, js_value_t *&result) {
+    if (value) {
+      return js_type_info_t<T>::template marshall<options>(env, *value, result);
+    }
+
+    return js_get_undefined(env, &result);
+  }
+
+  template <js_type_options_t options>
+  static auto
+  unmarshall(js_env_t *env, js_value_t *value, std::optional<T> &result) {
+    int err;
+
+    bool is_undefined;
+    err = js_is_undefined(env, value, &is_undefined);
+    if (err < 0) return err;
+
+    if (is_undefined) {
+      result = std::nullopt;
+    } else {
+      T unmarshalled;
+      err = js_type_info_t<T>::template unmarshall<options>(env, value, unmarshalled);
+      if (err < 0) return err;
+
+      result = std::optional(unmarshalled);
+    }
+
+    return 0;
+  }
+};
+
+template <typename T>
+struct js_property_t {
+  js_property_t(const std::string &name, T value) : name_(name), value_(value) {}
+
+  template <size_t N>
+  js_property_t(const char name[N], T value) : name_(name, N), value_(value) {}
+
+  js_property_t(const char *name, T value) : name_(name), value_(value) {}
+
+  const std::string &
+  name() const {
+    return name_;
+  }
+
+  const T &
+  value() const {
+    return value_;
+  }
+
+private:
+  std::string name_;
+  T value_;
+};
+
+template <js_string_literal_t literal, typename T>
+struct js_literal_property_t {
+  js_literal_property_t(T value) : value_(value) {}
+
+  static constexpr const char *
+  name() {
+    return literal.data();
+  }
+
+  const T &
+  value() const {
+    return value_;
+  }
+
+private:
+  T value_;
+};
+
+template <typename T>
+static inline auto
+js_marshall_typed_value(T value) {
+  int err;
+
+  typename js_type_info_t<T>::type result;
+  err = js_type_info_t<T>::marshall(value, result);
+  if (err < 0) throw err;
+
+  return result;
+}
+
+template <js_type_options_t options = js_type_options_t(), typename T>
+static inline auto
+js_marshall_typed_value(js_env_t *env, T value) {
+  int err;
+
+  typename js_type_info_t<T>::type result;
+  err = js_type_info_t<T>::template marshall<options>(env, value, result);
+  if (err < 0) throw err;
+
+  return result;
+}
+
+template <js_type_options_t options = js_type_options_t(), typename T>
+static inline auto
+js_marshall_untyped_value(js_env_t *env, T value) {
+  int err;
+
+  js_value_t *result;
+  err = js_type_info_t<T>::template marshall<options>(env, value, result);
+  if (err < 0) throw err;
+
+  return result;
+}
+
+template <js_type_options_t options = js_type_options_t()>
+static inline auto
+js_marshall_untyped_value(js_env_t *env) {
+  int err;
+
+  js_value_t *result;
+  err = js_type_info_t<void>::template marshall<options>(env, result);
+  if (err < 0) throw err;
+
+  return result;
+}
+
+template <typename T>
+static inline auto
+js_unmarshall_typed_value(typename js_type_info_t<T>::type value) {
+  int err;
+
+  T result;
+  err = js_type_info_t<T>::unmarshall(value, result);
+  if (err < 0) throw err;
+
+  return result;
+}
+
+template <js_type_options_t options = js_type_options_t(), typename T>
+static inline auto
+js_unmarshall_typed_value(js_env_t *env, typename js_type_info_t<T>::type value) {
+  int err;
+
+  T result;
+  err = js_type_info_t<T>::template unmarshall<options>(env, value, result);
+  if (err < 0) throw err;
+
+  return result;
+}
+
+template <js_type_options_t options = js_type_options_t(), typename T>
+static inline auto
+js_unmarshall_untyped_value(js_env_t *env, js_value_t *value) {
+  int err;
+
+  T result;
+  err = js_type_info_t<T>::template unmarshall<options>(env, value, result);
+  if (err < 0) throw err;
+
+  return result;
+}
+
+template <typename...>
+struct js_argument_info_t;
+
+template <>
+struct js_argument_info_t<> {
+  static constexpr bool has_receiver = false;
+};
+
+template <typename T, typename... R>
+struct js_argument_info_t<T, R...> {
+  static constexpr bool has_receiver = js_is_same<T, js_receiver_t>;
+};
+
+struct js_function_call_t {
+  enum type_t {
+    typed,
+    untyped
+  };
+
+  type_t type;
+};
+
+struct js_function_statistics_t {
+  uint64_t
+  calls() const {
+    return typed_calls_ + untyped_calls_;
+  }
+
+  uint64_t
+  calls(js_function_call_t::type_t type) const {
+    switch (type) {
+    case js_function_call_t::typed:
+      return typed_calls_;
+    case js_function_call_t::untyped:
+      return untyped_calls_;
+    }
+  }
+
+  bool
+  optimized() const {
+    return typed_calls_ > 0;
+  }
+
+  void
+  event(js_function_call_t call) {
+    switch (call.type) {
+    case js_function_call_t::typed:
+      typed_calls_++;
+      break;
+    case js_function_call_t::untyped:
+      untyped_calls_++;
+      break;
+    }
+  }
+
+private:
+  uint64_t typed_calls_ = 0;
+  uint64_t untyped_calls_ = 0;
+};
+
+struct js_function_options_t : js_type_options_t {
+  bool scoped = true;
+
+  bool elide_scope = false;
+
+  bool cached = false;
+
+  js_function_statistics_t *statistics = nullptr;
+
+  constexpr js_function_options_t() = default;
+
+  constexpr js_function_options_t(const js_function_options_t &that) : js_type_options_t(that), scoped(that.scoped), elide_scope(that.elide_scope), cached(that.cached), statistics(that.statistics) {}
+
+  constexpr js_function_options_t(js_function_statistics_t *statistics) : statistics(statistics) {}
+};
+
+template <typename T>
+concept js_primitive_type =
+  js_is_same<T, void> ||
+  (std::is_scalar_v<typename js_type_info_t<T>::type> && !js_is_same<typename js_type_info_t<T>::type, js_value_t *>);
+
+enum js_scope_strategy_t {
+  js_scope_none,
+  js_scope_plain,
+  js_scope_escapable,
+};
+
+template <js_function_options_t options, typename R, typename... A>
+constexpr js_scope_strategy_t js_scope_strategy =
+  !options.scoped
+    ? js_scope_none
+  : options.elide_scope && js_primitive_type<R> && ((js_primitive_type<A> || js_is_same<A, js_receiver_t>) && ...)
+    ? js_scope_none
+  : js_primitive_type<R>
+    ? js_scope_plain
+    : js_scope_escapable;
+
+template <auto fn, bool closure = false>
+struct js_typed_callback_t;
+
+template <typename R, typename... A, R fn(A...)>
+struct js_typed_callback_t<fn> {
+  template <js_function_options_t options>
+  static auto
+  create() {
+    return +[](typename js_type_info_t<A>::type... args, js_typed_callback_info_t *info) -> typename js_type_info_t<R>::type {
+      if constexpr (options.statistics) options.statistics->event({js_function_call_t::typed});
+
+      try {
+        return js_marshall_typed_value<R>(fn(js_unmarshall_typed_value<A>(std::move(args))...));
+      } catch (...) {
+        return R();
+      }
+    };
+  }
+};
+
+template <typename... A, void fn(A...)>
+struct js_typed_callback_t<fn> {
+  template <js_function_options_t options>
+  static auto
+  create() {
+    return +[](typename js_type_info_t<A>::type... args, js_typed_callback_info_t *info) -> void {
+      if constexpr (options.statistics) options.statistics->event({js_function_call_t::typed});
+
+      fn(js_unmarshall_typed_value<A>(std::move(args))...);
+    };
+  }
+};
+
+static inline int
+js_check_argument_count(js_env_t *env, size_t argc, size_t expected) {
+  int err;
+
+  if (argc >= expected) return 0;
+
+  err = js_throw_type_errorf(env, nullptr, "Expected %zu arguments, received %zu", expected, argc);
+  assert(err == 0);
+
+  return js_pending_exception;
+}
+
+template <typename... A>
+static inline int
+js_get_untyped_arguments(js_env_t *env, js_callback_info_t *info, js_value_t **argv, void **data = nullptr) {
+  int err;
+
+  size_t argc = sizeof...(A);
+
+  if constexpr (js_argument_info_t<A...>::has_receiver) {
+    argc--;
+
+    err = js_get_callback_info(env, info, &argc, &argv[1], &argv[0], data);
+    assert(err == 0);
+
+    return js_check_argument_count(env, argc, sizeof...(A) - 1);
+  } else {
+    err = js_get_callback_info(env, info, &argc, argv, nullptr, data);
+    assert(err == 0);
+
+    return js_check_argument_count(env, argc, sizeof...(A));
+  }
+}
+
+template <auto fn, typename T, typename R, typename... A>
+struct js_env_callback_t {
+  template <typename... U>
+  static R
+  call(js_env_t *env, void *data, U &&...args) {
+    if constexpr (js_is_same<T, void>) {
+      return fn(env, std::forward<U>(args)...);
+    } else {
+      return fn(env, reinterpret_cast<T *>(data), std::forward<U>(args)...);
+    }
+  }
+
+  template <js_function_options_t options>
+  static auto
+  create_typed() {
+    constexpr auto strategy = js_scope_strategy<options, R, A...>;
+
+    if constexpr (strategy == js_scope_escapable) {
+      return create_typed_with_escapable_scope<options>();
+    } else {
+      return create_typed_with_scope<options, strategy == js_scope_plain>();
+    }
+  }
+
+  template <js_function_options_t options>
+  static auto
+  create_untyped() {
+    return +[](js_env_t *env, js_callback_info_t *info) -> js_value_t * {
+      int err;
+
+      js_value_t *argv[sizeof...(A)];
+      void *data;
+      err = js_get_untyped_arguments<A...>(env, info, argv, &data);
+      if (err < 0) return nullptr;
+
+      return call_untyped<options>(env, argv, data);
+    };
+  }
+
+  template <js_function_options_t options>
+  static js_value_t *
+  call_untyped(js_env_t *env, js_value_t *const argv[], void *data) {
+    constexpr auto strategy = js_scope_strategy<options, R, A...>;
+
+    if constexpr (strategy == js_scope_escapable) {
+      return call_untyped_with_escapable_scope<options>(env, argv, data, std::index_sequence_for<A...>());
+    } else {
+      return call_untyped_with_scope<options, strategy == js_scope_plain>(env, argv, data, std::index_sequence_for<A...>());
+    }
+  }
+
+private:
+  template <js_function_options_t options, bool scoped>
+  static auto
+  create_typed_with_scope() {
+    return +[](typename js_type_info_t<A>::type... args, js_typed_callback_info_t *info) -> typename js_type_info_t<R>::type {
+      int err;
+
+      if constexpr (options.statistics) options.statistics->event({js_function_call_t::typed});
+
+      js_env_t *env;
+      void *data;
+      err = js_get_typed_callback_info(info, &env, &data);
+      assert(err == 0);
+
+      js_handle_scope_t *scope;
+
+      if constexpr (scoped) {
+        err = js_open_handle_scope(env, &scope);
+        assert(err == 0);
+      }
+
+      if constexpr (js_is_same<R, void>) {
+        try {
+          call(env, data, js_unmarshall_typed_value<js_type_options_t(options), A>(env, std::move(args))...);
+        } catch (...) {
+        }
+
+        if constexpr (scoped) {
+          err = js_close_handle_scope(env, scope);
+          assert(err == 0);
+        }
+      } else {
+        typename js_type_info_t<R>::type result{};
+
+        try {
+          result = js_marshall_typed_value<js_type_options_t(options), R>(env, call(env, data, js_unmarshall_typed_value<js_type_options_t(options), A>(env, std::move(args))...));
+        } catch (...) {
+        }
+
+        if constexpr (scoped) {
+          err = js_close_handle_scope(env, scope);
+          assert(err == 0);
+        }
+
+        return result;
+      }
+    };
+  }
+
+  template <js_function_options_t options>
+  static auto
+  create_typed_with_escapable_scope() {
+    return +[](typename js_type_info_t<A>::type... args, js_typed_callback_info_t *info) -> typename js_type_info_t<R>::type {
+      int err;
+
+      if constexpr (options.statistics) options.statistics->event({js_function_call_t::typed});
+
+      js_env_t *env;
+      void *data;
+      err = js_get_typed_callback_info(info, &env, &data);
+      assert(err == 0);
+
+      js_escapable_handle_scope_t *scope;
+      err = js_open_escapable_handle_scope(env, &scope);
+      assert(err == 0);
+
+      typename js_type_info_t<R>::type result{};
+
+      try {
+        result = js_marshall_typed_value<js_type_options_t(options), R>(env, call(env, data, js_unmarshall_typed_value<js_type_options_t(options), A>(env, std::move(args))...));
+
+        err = js_escape_handle(env, scope, result, &result);
+        assert(err == 0);
+      } catch (...) {
+      }
+
+      err = js_close_escapable_handle_scope(env, scope);
+      assert(err == 0);
+
+      return result;
+    };
+  }
+
+  template <js_function_options_t options, bool scoped, size_t... I>
+  static js_value_t *
+  call_untyped_with_scope(js_env_t *env, js_value_t *const argv[], void *data, std::index_sequence<I...>) {
+    int err;
+
+    if constexpr (options.statistics) options.statistics->event({js_function_call_t::untyped});
+
+    js_handle_scope_t *scope;
+
+    if constexpr (scoped) {
+      err = js_open_handle_scope(env, &scope);
+      assert(err == 0);
+    }
+
+    if constexpr (js_is_same<R, void>) {
+      try {
+        call(env, data, js_unmarshall_untyped_value<js_type_options_t(options), A>(env, argv[I])...);
+      } catch (...) {
+      }
+
+      if constexpr (scoped) {
+        err = js_close_handle_scope(env, scope);
+        assert(err == 0);
+      }
+
+      return js_marshall_untyped_value<js_type_options_t(options)>(env);
+    } else {
+      R value;
+
+      try {
+        value = call(env, data, js_unmarshall_untyped_value<js_type_options_t(options), A>(env, argv[I])...);
+      } catch (...) {
+        if constexpr (scoped) {
+          err = js_close_handle_scope(env, scope);
+          assert(err == 0);
+        }
+
+        return nullptr;
+      }
+
+      if constexpr (scoped) {
+        err = js_close_handle_scope(env, scope);
+        assert(err == 0);
+      }
+
+      js_value_t *result;
+
+      try {
+        result = js_marshall_untyped_value<js_type_options_t(options), R>(env, std::move(value));
+      } catch (...) {
+        result = nullptr;
+      }
+
+      return result;
+    }
+  }
+
+  template <js_function_options_t options, size_t... I>
+  static js_value_t *
+  call_untyped_with_escapable_scope(js_env_t *env, js_value_t *const argv[], void *data, std::index_sequence<I...>) {
+    int err;
+
+    if constexpr (options.statistics) options.statistics->event({js_function_call_t::untyped});
+
+    js_escapable_handle_scope_t *scope;
+    err = js_open_escapable_handle_scope(env, &scope);
+    assert(err == 0);
+
+    js_value_t *result;
+
+    try {
+      result = js_marshall_untyped_value<js_type_options_t(options), R>(env, call(env, data, js_unmarshall_untyped_value<js_type_options_t(options), A>(env, argv[I])...));
+
+      err = js_escape_handle(env, scope, result, &result);
+      assert(err == 0);
+    } catch (...) {
+      result = nullptr;
+    }
+
+    err = js_close_escapable_handle_scope(env, scope);
+    assert(err == 0);
+
+    return result;
+  }
+};
+
+template <typename R, typename... A, R fn(js_env_t *, A...)>
+struct js_typed_callback_t<fn> {
+  template <js_function_options_t options>
+  static auto
+  create() {
+    return js_env_callback_t<fn, void, R, A...>::template create_typed<options>();
+  }
+};
+
+template <typename... A, void fn(js_env_t *, A...)>
+struct js_typed_callback_t<fn> {
+  template <js_function_options_t options>
+  static auto
+  create() {
+    return js_env_callback_t<fn, void, void, A...>::template create_typed<options>();
+  }
+};
+
+template <typename T, typename R, typename... A, R fn(js_env_t *, T *, A...)>
+struct js_typed_callback_t<fn, true> {
+  template <js_function_options_t options>
+  static auto
+  create() {
+    return js_env_callback_t<fn, T, R, A...>::template create_typed<options>();
+  }
+};
+
+template <auto fn, bool closure = false>
+struct js_untyped_callback_t;
+
+template <typename R, typename... A, R fn(A...)>
+struct js_untyped_callback_t<fn> {
+  template <js_function_options_t options>
+  static auto
+  create() {
+    return +[](js_env_t *env, js_callback_info_t *info) -> js_value_t * {
+      int err;
+
+      js_value_t *argv[sizeof...(A)];
+      err = js_get_untyped_arguments<A...>(env, info, argv);
+      if (err < 0) return nullptr;
+
+      return call<options>(env, argv);
+    };
+  }
+
+  template <js_function_options_t options>
+  static js_value_t *
+  call(js_env_t *env, js_value_t *const argv[]) {
+    return call<options>(env, argv, std::index_sequence_for<A...>());
+  }
+
+private:
+  template <js_function_options_t options, size_t... I>
+  static js_value_t *
+  call(js_env_t *env, js_value_t *const argv[], std::index_sequence<I...>) {
+    if constexpr (options.statistics) options.statistics->event({js_function_call_t::untyped});
+
+    js_value_t *result;
+
+    try {
+      result = js_marshall_untyped_value<js_type_options_t(options), R>(env, fn(js_unmarshall_untyped_value<js_type_options_t(options), A>(env, argv[I])...));
+    } catch (...) {
+      result = nullptr;
+    }
+
+    return result;
+  }
+};
+
+template <typename... A, void fn(A...)>
+struct js_untyped_callback_t<fn> {
+  template <js_function_options_t options>
+  static auto
+  create() {
+    return +[](js_env_t *env, js_callback_info_t *info) -> js_value_t * {
+      int err;
+
+      js_value_t *argv[sizeof...(A)];
+      err = js_get_untyped_arguments<A...>(env, info, argv);
+      if (err < 0) return nullptr;
 
-    std::vector<js_value_t *> values(len);
-    err = js_get_array_elements(env, value, values.data(), len, 0, &len);
-    if (err < 0) return err;
+      return call<options>(env, argv);
+    };
+  }
 
-    result.resize(len);
+  template <js_function_options_t options>
+  static js_value_t *
+  call(js_env_t *env, js_value_t *const argv[]) {
+    return call<options>(env, argv, std::index_sequence_for<A...>());
+  }
 
-    for (uint32_t i = 0; i < len; i++) {
-      err = js_type_info_t<T>::template unmarshall<options>(env, values[i], result[i]);
-      if (err < 0) return err;
+private:
+  template <js_function_options_t options, size_t... I>
+  static js_value_t *
+  call(js_env_t *env, js_value_t *const argv[], std::index_sequence<I...>) {
+    if constexpr (options.statistics) options.statistics->event({js_function_call_t::untyped});
+
+    try {
+      fn(js_unmarshall_untyped_value<js_type_options_t(options), A>(env, argv[I])...);
+    } catch (...) {
     }
 
-    return 0;
+    return js_marshall_untyped_value<js_type_options_t(options)>(env);
   }
 };
 
-template <typename... T>
-struct js_type_info_t<std::tuple<T...>> {
-  using type = js_value_t *;
-
-  static constexpr auto signature = js_object;
-
-  template <js_type_options_t options, size_t... I>
+template <typename R, typename... A, R fn(js_env_t *, A...)>
+struct js_untyped_callback_t<fn> {
+  template <js_function_options_t options>
   static auto
-  marshall(js_env_t *env, std::tuple<T...> &tuple, js_value_t *&result, std::index_sequence<I...>) {
-    int err;
-    err = js_create_array_with_length(env, sizeof...(T), &result);
-    assert(err == 0);
-
-    try {
-      js_value_t *values[] = {
-        js_marshall_untyped_value<options, T>(env, std::get<I>(tuple))...
-      };
+  create() {
+    return js_env_callback_t<fn, void, R, A...>::template create_untyped<options>();
+  }
 
-      return js_set_array_elements(env, result, const_cast<const js_value_t **>(values), sizeof...(T), 0);
-    } catch (int err) {
-      return err;
-    }
+  template <js_function_options_t options>
+  static js_value_t *
+  call(js_env_t *env, js_value_t *const argv[]) {
+    return js_env_callback_t<fn, void, R, A...>::template call_untyped<options>(env, argv, nullptr);
   }
+};
 
-  template <js_type_options_t options>
+template <typename... A, void fn(js_env_t *, A...)>
+struct js_untyped_callback_t<fn> {
+  template <js_function_options_t options>
   static auto
-  marshall(js_env_t *env, std::tuple<T...> &tuple, js_value_t *&result) {
-    return marshall<options>(env, tuple, result, std::index_sequence_for<T...>());
+  create() {
+    return js_env_callback_t<fn, void, void, A...>::template create_untyped<options>();
   }
 
-  template <js_type_options_t options, size_t... I>
+  template <js_function_options_t options>
+  static js_value_t *
+  call(js_env_t *env, js_value_t *const argv[]) {
+    return js_env_callback_t<fn, void, void, A...>::template call_untyped<options>(env, argv, nullptr);
+  }
+};
+
+template <typename T, typename R, typename... A, R fn(js_env_t *, T *, A...)>
+struct js_untyped_callback_t<fn, true> {
+  template <js_function_options_t options>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, std::tuple<T...> &result, std::index_sequence<I...>) {
-    int err;
+  create() {
+    return js_env_callback_t<fn, T, R, A...>::template create_untyped<options>();
+  }
+};
 
-    if constexpr (options.checked) {
-      err = js_check_value<js_is_array>(env, value, "array");
-      if (err < 0) return err;
-    }
+template <auto fn, js_function_options_t options = js_function_options_t()>
+static inline auto
+js_create_typed_callback() {
+  return js_typed_callback_t<fn>::template create<options>();
+}
 
-    js_value_t *values[sizeof...(T)];
-    uint32_t len;
-    err = js_get_array_elements(env, value, values, sizeof...(T), 0, &len);
-    if (err < 0) return err;
+template <auto fn, js_function_options_t options = js_function_options_t()>
+static inline auto
+js_create_untyped_callback() {
+  return js_untyped_callback_t<fn>::template create<options>();
+}
 
-    assert(len == sizeof...(T));
+template <typename R, typename... A>
+struct js_callback_signature_info_t {
+  static inline int args[sizeof...(A) + 1] = {
+    js_type_info_t<A>::signature...
+  };
 
-    try {
-      result = {
-        js_unmarshall_untyped_value<options, T>(env, values[I])...
-      };
+  static constexpr js_callback_signature_t signature = [] {
+    js_callback_signature_t signature;
 
-      return 0;
-    } catch (int err) {
-      return err;
-    }
-  }
+    signature.version = 0;
+    signature.result = js_type_info_t<R>::signature;
+    signature.args_len = sizeof...(A);
+    signature.args = args;
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, std::tuple<T...> &result) {
-    return unmarshall<options>(env, value, result, std::index_sequence_for<T...>());
-  }
+    return signature;
+  }();
 };
 
-template <typename T>
-struct js_type_info_t<std::span<T>> {
-  using type = js_value_t *;
+template <auto fn>
+struct js_function_info_t;
 
-  static constexpr auto signature = js_object;
+template <typename R, typename... A, R fn(A...)>
+struct js_function_info_t<fn> {
+  using type = js_function_t<R, A...>;
 
-  template <js_type_options_t options>
+  template <js_function_options_t options>
   static auto
-  marshall(js_env_t *env, std::span<T> &view, js_value_t *&result) {
-    int err;
-
-    js_value_t *arraybuffer;
+  marshall(js_env_t *env, const char *name, size_t len, js_function_t<R, A...> &result) {
+    auto typed = js_create_typed_callback<fn, options>();
 
-    T *data;
-    err = js_create_arraybuffer(env, view.size_bytes(), reinterpret_cast<void **>(&data), &arraybuffer);
-    if (err < 0) return err;
+    auto untyped = js_create_untyped_callback<fn, options>();
 
-    std::copy(view.begin(), view.end(), data);
+    constexpr auto signature = &js_callback_signature_info_t<R, A...>::signature;
 
-    return js_create_typedarray(env, js_typedarray_info_t<T>::type, view.size(), arraybuffer, 0, &result);
+    return js_create_typed_function(env, name, len, untyped, signature, reinterpret_cast<const void *>(typed), nullptr, static_cast<js_value_t **>(result));
   }
 
-  template <js_type_options_t options>
+  template <js_function_options_t options>
   static auto
-  unmarshall(js_env_t *env, js_value_t *value, std::span<T> &result) {
+  marshall(js_env_t *env, const char *name, size_t len, js_handle_t &result) {
     int err;
 
-    if constexpr (options.checked) {
-      err = js_check_value<js_is_typedarray<T>>(env, value, js_typedarray_info_t<T>::label);
-      if (err < 0) return err;
-    }
-
-    T *data;
-    size_t len;
-    err = js_get_typedarray_info(env, value, nullptr, reinterpret_cast<void **>(&data), &len, nullptr, nullptr);
+    js_function_t<R, A...> value;
+    err = marshall<options>(env, name, len, value);
     if (err < 0) return err;
 
-    result = std::span(data, len);
+    result = value;
 
     return 0;
   }
 };
 
-template <typename T>
-struct js_type_info_t<std::span<const T>> {
-  using type = js_value_t *;
+template <typename R, typename... A, R fn(js_env_t *, A...)>
+struct js_function_info_t<fn> {
+  using type = js_function_t<R, A...>;
 
-  static constexpr auto signature = js_object;
+  template <js_function_options_t options>
+  static auto
+  marshall(js_env_t *env, const char *name, size_t len, js_function_t<R, A...> &result) {
+    auto typed = js_create_typed_callback<fn, options>();
 
-  template <js_type_options_t options>
+    auto untyped = js_create_untyped_callback<fn, options>();
+
+    constexpr auto signature = &js_callback_signature_info_t<R, A...>::signature;
+
+    return js_create_typed_function(env, name, len, untyped, signature, reinterpret_cast<const void *>(typed), nullptr, static_cast<js_value_t **>(result));
+  }
+
+  template <js_function_options_t options>
   static auto
-  marshall(js_env_t *env, const std::span<const T> &view, js_value_t *&result) {
+  marshall(js_env_t *env, const char *name, size_t len, js_handle_t &result) {
     int err;
 
-    js_value_t *arraybuffer;
-
-    T *data;
-    err = js_create_arraybuffer(env, view.size_bytes(), reinterpret_cast<void **>(&data), &arraybuffer);
+    js_function_t<R, A...> value;
+    err = marshall<options>(env, name, len, value);
     if (err < 0) return err;
 
-    std::copy(view.begin(), view.end(), data);
+    result = value;
 
-    return js_create_typedarray(env, js_typedarray_info_t<T>::type, view.size(), arraybuffer, 0, &result);
+    return 0;
   }
 };
 
 template <typename T>
-struct js_type_info_t<std::optional<T>> {
-  using type = js_value_t *;
+static inline T *
+js_unwrap_receiver(js_env_t *env, js_receiver_t receiver) {
+  int err;
 
-  static constexpr auto signature = js_type_info_t<T>::signature;
+  T *self;
+  err = js_unwrap(env, static_cast<js_value_t *>(receiver), reinterpret_cast<void **>(&self));
 
-  template <js_type_options_t options>
-  static auto
-  marshall(js_env_t *env, std::optional<T> &value, js_value_t *&result) {
-    if (value) {
-      return js_type_info_t<T>::template marshall<options>(env, *value, result);
+  if (err < 0) {
+    bool pending;
+    err = js_is_exception_pending(env, &pending);
+    assert(err == 0);
+
+    if (!pending) {
+      err = js_throw_type_error(env, nullptr, "Illegal invocation");
+      assert(err == 0);
     }
 
-    return js_get_undefined(env, &result);
+    throw js_pending_exception;
   }
 
-  template <js_type_options_t options>
-  static auto
-  unmarshall(js_env_t *env, js_value_t *value, std::optional<T> &result) {
-    int err;
+  return self;
+}
 
-    bool is_undefined;
-    err = js_is_undefined(env, value, &is_undefined);
-    if (err < 0) return err;
+template <auto fn>
+struct js_method_info_t;
 
-    if (is_undefined) {
-      result = std::nullopt;
-    } else {
-      T unmarshalled;
-      err = js_type_info_t<T>::template unmarshall<options>(env, value, unmarshalled);
-      if (err < 0) return err;
+template <typename T, typename R, typename... A, R fn(js_env_t *, T *, A...)>
+struct js_method_info_t<fn> {
+  using type = T;
 
-      result = std::optional(unmarshalled);
-    }
+  static R
+  call(js_env_t *env, js_receiver_t receiver, A... args) {
+    auto self = js_unwrap_receiver<T>(env, receiver);
 
-    return 0;
+    return fn(env, self, std::move(args)...);
   }
 };
 
-template <typename T>
-struct js_property_t {
-  js_property_t(const std::string &name, T value) : name_(name), value_(value) {}
-
-  template <size_t N>
-  js_property_t(const char name[N], T value) : name_(name, N), value_(value) {}
+template <typename T, typename R, typename... A, R (T::*fn)(A...)>
+struct js_method_info_t<fn> {
+  using type = T;
 
-  js_property_t(const char *name, T value) : name_(name), value_(value) {}
+  static R
+  call(js_env_t *env, js_receiver_t receiver, A... args) {
+    auto self = js_unwrap_receiver<T>(env, receiver);
 
-  const std::string &
-  name() const {
-    return name_;
+    return (self->*fn)(std::move(args)...);
   }
+};
 
-  const T &
-  value() const {
-    return value_;
-  }
+template <typename T, typename R, typename... A, R (T::*fn)(A...) const>
+struct js_method_info_t<fn> {
+  using type = T;
 
-private:
-  std::string name_;
-  T value_;
+  static R
+  call(js_env_t *env, js_receiver_t receiver, A... args) {
+    auto self = js_unwrap_receiver<T>(env, receiver);
+
+    return (self->*fn)(std::move(args)...);
+  }
 };
 
-template <typename T>
-static inline auto
-js_marshall_typed_value(T value) {
-  int err;
+template <typename T, typename R, typename... A, R (T::*fn)(js_env_t *, A...)>
+struct js_method_info_t<fn> {
+  using type = T;
 
-  typename js_type_info_t<T>::type result;
-  err = js_type_info_t<T>::marshall(value, result);
-  if (err < 0) throw err;
+  static R
+  call(js_env_t *env, js_receiver_t receiver, A... args) {
+    auto self = js_unwrap_receiver<T>(env, receiver);
 
-  return result;
-}
+    return (self->*fn)(env, std::move(args)...);
+  }
+};
 
-template <js_type_options_t options = js_type_options_t(), typename T>
-static inline auto
-js_marshall_typed_value(js_env_t *env, T value) {
-  int err;
+template <typename T, typename R, typename... A, R (T::*fn)(js_env_t *, A...) const>
+struct js_method_info_t<fn> {
+  using type = T;
 
-  typename js_type_info_t<T>::type result;
-  err = js_type_info_t<T>::template marshall<options>(env, value, result);
-  if (err < 0) throw err;
+  static R
+  call(js_env_t *env, js_receiver_t receiver, A... args) {
+    auto self = js_unwrap_receiver<T>(env, receiver);
 
-  return result;
-}
+    return (self->*fn)(env, std::move(args)...);
+  }
+};
 
-template <js_type_options_t options = js_type_options_t(), typename T>
-static inline auto
-js_marshall_untyped_value(js_env_t *env, T value) {
-  int err;
+template <auto fn>
+  requires std::is_member_function_pointer_v<decltype(fn)>
+struct js_typed_callback_t<fn> : js_typed_callback_t<js_method_info_t<fn>::call> {};
 
-  js_value_t *result;
-  err = js_type_info_t<T>::template marshall<options>(env, value, result);
-  if (err < 0) throw err;
+template <auto fn>
+  requires std::is_member_function_pointer_v<decltype(fn)>
+struct js_untyped_callback_t<fn> : js_untyped_callback_t<js_method_info_t<fn>::call> {};
 
-  return result;
-}
+template <auto fn>
+  requires std::is_member_function_pointer_v<decltype(fn)>
+struct js_function_info_t<fn> : js_function_info_t<js_method_info_t<fn>::call> {};
 
-template <js_type_options_t options = js_type_options_t()>
-static inline auto
-js_marshall_untyped_value(js_env_t *env) {
-  int err;
+template <typename F, js_function_options_t options>
+struct js_function_cache_t {
+  template <typename T>
+  static int
+  marshall(js_env_t *env, const char *name, size_t len, T &result) {
+    int err;
 
-  js_value_t *result;
-  err = js_type_info_t<void>::template marshall<options>(env, result);
-  if (err < 0) throw err;
+    auto &function = function_.get(env);
 
-  return result;
-}
+    if (function) {
+      if constexpr (js_is_debug) {
+        if (name_.get(env) != label(name, len)) {
+          err = js_throw_type_error(env, nullptr, "Cached function was created with a different name");
+          assert(err == 0);
 
-template <typename T>
-static inline auto
-js_unmarshall_typed_value(typename js_type_info_t<T>::type value) {
-  int err;
+          return js_pending_exception;
+        }
+      }
 
-  T result;
-  err = js_type_info_t<T>::unmarshall(value, result);
-  if (err < 0) throw err;
+      js_value_t *value;
+      err = js_get_reference_value(env, static_cast<js_ref_t *>(function), &value);
+      if (err < 0) return err;
 
-  return result;
-}
+      result = T(value);
 
-template <js_type_options_t options = js_type_options_t(), typename T>
-static inline auto
-js_unmarshall_typed_value(js_env_t *env, typename js_type_info_t<T>::type value) {
-  int err;
+      return 0;
+    }
 
-  T result;
-  err = js_type_info_t<T>::template unmarshall<options>(env, value, result);
-  if (err < 0) throw err;
+    err = F::template marshall<options>(env, name, len, result);
+    if (err < 0) return err;
 
-  return result;
-}
+    js_ref_t *ref;
+    err = js_create_reference(env, static_cast<js_value_t *>(result), 1, &ref);
+    if (err < 0) return err;
 
-template <js_type_options_t options = js_type_options_t(), typename T>
-static inline auto
-js_unmarshall_untyped_value(js_env_t *env, js_value_t *value) {
-  int err;
+    function = js_persistent_t<js_handle_t>(env, ref);
 
-  T result;
-  err = js_type_info_t<T>::template unmarshall<options>(env, value, result);
-  if (err < 0) throw err;
+    if constexpr (js_is_debug) name_.get(env) = label(name, len);
 
-  return result;
-}
+    return 0;
+  }
 
-template <typename...>
-struct js_argument_info_t;
+private:
+  static inline js_env_local_t<js_persistent_t<js_handle_t>> function_;
 
-template <>
-struct js_argument_info_t<> {
-  static constexpr bool has_receiver = false;
-};
+  static inline js_env_local_t<std::string> name_;
 
-template <typename T, typename... R>
-struct js_argument_info_t<T, R...> {
-  static constexpr bool has_receiver = js_is_same<T, js_receiver_t>;
-};
+  static std::string_view
+  label(const char *name, size_t len) {
+    if (name == nullptr) return std::string_view();
 
-struct js_function_call_t {
-  enum type_t {
-    typed,
-    untyped
-  };
+    if (len == size_t(-1)) return std::string_view(name);
 
-  type_t type;
+    return std::string_view(name, len);
+  }
 };
 
-struct js_function_statistics_t {
-  uint64_t
-  calls() const {
-    return typed_calls_ + untyped_calls_;
+template <typename F, js_function_options_t options, typename T>
+static inline int
+js_marshall_function(js_env_t *env, const char *name, size_t len, T &result) {
+  if constexpr (options.cached) {
+    return js_function_cache_t<F, options>::marshall(env, name, len, result);
+  } else {
+    return F::template marshall<options>(env, name, len, result);
   }
+}
 
-  uint64_t
-  calls(js_function_call_t::type_t type) const {
-    switch (type) {
-    case js_function_call_t::typed:
-      return typed_calls_;
-    case js_function_call_t::untyped:
-      return untyped_calls_;
-    }
-  }
+template <auto fn, js_function_options_t options, typename T>
+static inline int
+js_marshall_function(js_env_t *env, const char *name, size_t len, T &result) {
+  return js_marshall_function<js_function_info_t<fn>, options>(env, name, len, result);
+}
 
-  bool
-  optimized() const {
-    return typed_calls_ > 0;
-  }
+template <auto fn>
+struct js_closure_info_t;
 
-  void
-  event(js_function_call_t call) {
-    switch (call.type) {
-    case js_function_call_t::typed:
-      typed_calls_++;
-      break;
-    case js_function_call_t::untyped:
-      untyped_calls_++;
-      break;
-    }
-  }
+template <typename T, typename R, typename... A, R fn(js_env_t *, T *, A...)>
+struct js_closure_info_t<fn> {
+  using type = js_function_t<R, A...>;
 
-private:
-  uint64_t typed_calls_ = 0;
-  uint64_t untyped_calls_ = 0;
+  template <js_function_options_t options>
+  static auto
+  marshall(js_env_t *env, const char *name, size_t len, T *data, js_function_t<R, A...> &result) {
+    auto typed = js_typed_callback_t<fn, true>::template create<options>();
+
+    auto untyped = js_untyped_callback_t<fn, true>::template create<options>();
+
+    constexpr auto signature = &js_callback_signature_info_t<R, A...>::signature;
+
+    return js_create_typed_function(env, name, len, untyped, signature, reinterpret_cast<const void *>(typed), reinterpret_cast<void *>(data), static_cast<js_value_t **>(result));
+  }
 };
 
-struct js_function_options_t : js_type_options_t {
-  bool scoped = true;
+template <typename F, typename M = decltype(&F::operator())>
+struct js_callable_info_t;
 
-  js_function_statistics_t *statistics = nullptr;
+template <typename F, typename R, typename... A>
+struct js_callable_info_t<F, R (F::*)(A...)> {
+  using type = js_function_t<R, A...>;
 
-  constexpr js_function_options_t() = default;
+  static R
+  call(js_env_t *, F *callable, A... args) {
+    return (*callable)(std::move(args)...);
+  }
+};
 
-  constexpr js_function_options_t(const js_function_options_t &that) : js_type_options_t(that), scoped(that.scoped), statistics(that.statistics) {}
+template <typename F, typename R, typename... A>
+struct js_callable_info_t<F, R (F::*)(A...) const> {
+  using type = js_function_t<R, A...>;
 
-  constexpr js_function_options_t(js_function_statistics_t *statistics) : statistics(statistics) {}
+  static R
+  call(js_env_t *, F *callable, A... args) {
+    return (*callable)(std::move(args)...);
+  }
 };
 
-template <auto fn>
-struct js_typed_callback_t;
+template <typename F, typename R, typename... A>
+struct js_callable_info_t<F, R (F::*)(js_env_t *, A...)> {
+  using type = js_function_t<R, A...>;
 
-template <typename R, typename... A, R fn(A...)>
-struct js_typed_callback_t<fn> {
-  template <js_function_options_t options>
-  static auto
-  create() {
-    return +[](typename js_type_info_t<A>::type... args, js_typed_callback_info_t *info) -> typename js_type_info_t<R>::type {
-      if constexpr (options.statistics) options.statistics->event({js_function_call_t::typed});
+  static R
+  call(js_env_t *env, F *callable, A... args) {
+    return (*callable)(env, std::move(args)...);
+  }
+};
 
-      try {
-        return js_marshall_typed_value<R>(fn(js_unmarshall_typed_value<A>(std::move(args))...));
-      } catch (...) {
-        return R();
-      }
-    };
+template <typename F, typename R, typename... A>
+struct js_callable_info_t<F, R (F::*)(js_env_t *, A...) const> {
+  using type = js_function_t<R, A...>;
+
+  static R
+  call(js_env_t *env, F *callable, A... args) {
+    return (*callable)(env, std::move(args)...);
   }
 };
 
-template <typename R, typename... A, R fn(js_env_t *, A...)>
-struct js_typed_callback_t<fn> {
+template <auto fn>
+struct js_constructor_info_t;
+
+template <typename T, typename... A, T *fn(js_env_t *, A...)>
+struct js_constructor_info_t<fn> {
+  using type = T;
+
   template <js_function_options_t options>
   static auto
   create() {
-    if constexpr (options.scoped) {
-      if constexpr (js_is_same<typename js_type_info_t<R>::type, js_value_t *>) {
-        return create_with_escapable_scope<options>();
-      } else {
-        return create_with_scope<options>();
-      }
-    } else {
-      return create_without_scope<options>();
-    }
+    return create<options>(std::index_sequence_for<A...>());
   }
 
 private:
-  template <js_function_options_t options>
+  template <js_function_options_t options, size_t... I>
   static auto
-  create_with_scope() {
-    return +[](typename js_type_info_t<A>::type... args, js_typed_callback_info_t *info) -> typename js_type_info_t<R>::type {
+  create(std::index_sequence<I...>) {
+    return +[](js_env_t *env, js_callback_info_t *info) -> js_value_t * {
       int err;
 
-      if constexpr (options.statistics) options.statistics->event({js_function_call_t::typed});
+      if constexpr (options.statistics) options.statistics->event({js_function_call_t::untyped});
 
-      js_env_t *env;
-      err = js_get_typed_callback_info(info, &env, nullptr);
+      size_t argc = sizeof...(A);
+      js_value_t *argv[sizeof...(A)];
+      js_value_t *receiver;
+      err = js_get_callback_info(env, info, &argc, argv, &receiver, nullptr);
       assert(err == 0);
 
-      js_handle_scope_t *scope;
-      err = js_open_handle_scope(env, &scope);
+      js_value_t *new_target;
+      err = js_get_new_target(env, info, &new_target);
       assert(err == 0);
 
-      typename js_type_info_t<R>::type result;
+      if (new_target == nullptr) {
+        err = js_throw_type_error(env, nullptr, "Class constructor cannot be invoked without 'new'");
+        assert(err == 0);
+
+        return nullptr;
+      }
+
+      err = js_check_argument_count(env, argc, sizeof...(A));
+      if (err < 0) return nullptr;
+
+      T *self;
 
       try {
-        result = js_marshall_typed_value<js_type_options_t(options), R>(env, fn(env, js_unmarshall_typed_value<js_type_options_t(options), A>(env, std::move(args))...));
+        self = fn(env, js_unmarshall_untyped_value<js_type_options_t(options), A>(env, argv[I])...);
       } catch (...) {
+        return nullptr;
       }
 
-      err = js_close_handle_scope(env, scope);
-      assert(err == 0);
+      auto finalize = +[](js_env_t *, void *data, void *) {
+        delete reinterpret_cast<T *>(data);
+      };
 
-      return result;
+      err = js_wrap(env, receiver, reinterpret_cast<void *>(self), finalize, nullptr, nullptr);
+
+      if (err < 0) {
+        delete self;
+
+        return nullptr;
+      }
+
+      return receiver;
     };
   }
+};
 
-  template <js_function_options_t options>
-  static auto
-  create_with_escapable_scope() {
-    return +[](typename js_type_info_t<A>::type... args, js_typed_callback_info_t *info) -> typename js_type_info_t<R>::type {
-      int err;
+template <auto fn, js_function_options_t options = js_function_options_t()>
+struct js_method_t {};
 
-      if constexpr (options.statistics) options.statistics->event({js_function_call_t::typed});
+template <auto fn, js_function_options_t options = js_function_options_t()>
+struct js_static_method_t {};
 
-      js_env_t *env;
-      err = js_get_typed_callback_info(info, &env, nullptr);
-      assert(err == 0);
+template <auto get, auto set = nullptr, js_function_options_t options = js_function_options_t()>
+struct js_accessor_t {};
 
-      js_escapable_handle_scope_t *scope;
-      err = js_open_escapable_handle_scope(env, &scope);
-      assert(err == 0);
+template <js_string_literal_t name, auto fn, js_function_options_t options = js_function_options_t()>
+struct js_export_t {};
 
-      typename js_type_info_t<R>::type result;
+template <typename T>
+struct js_export_info_t;
 
-      try {
-        result = js_marshall_typed_value<js_type_options_t(options), R>(env, fn(env, js_unmarshall_typed_value<js_type_options_t(options), A>(env, std::move(args))...));
+template <js_string_literal_t name, auto fn, js_function_options_t options>
+struct js_export_info_t<js_export_t<name, fn, options>> {
+  static auto
+  lazy_descriptor(js_env_t *env) {
+    int err;
 
-        err = js_escape_handle(env, scope, result, &result);
-        assert(err == 0);
-      } catch (...) {
-      }
+    js_property_descriptor_t descriptor;
 
-      err = js_close_escapable_handle_scope(env, scope);
-      assert(err == 0);
+    descriptor.version = 0;
+    descriptor.data = nullptr;
+    descriptor.attributes = js_enumerable | js_configurable;
+    descriptor.method = nullptr;
+    descriptor.getter = on_get;
+    descriptor.setter = on_set;
+    descriptor.value = nullptr;
 
-      return result;
-    };
+    err = js_create_property_key_utf8(env, reinterpret_cast<const utf8_t *>(name.data()), name.length(), &descriptor.name);
+    if (err < 0) throw err;
+
+    return descriptor;
   }
 
-  template <js_function_options_t options>
   static auto
-  create_without_scope() {
-    return +[](typename js_type_info_t<A>::type... args, js_typed_callback_info_t *info) -> typename js_type_info_t<R>::type {
-      int err;
+  descriptor(js_env_t *env) {
+    int err;
 
-      if constexpr (options.statistics) options.statistics->event({js_function_call_t::typed});
+    js_property_descriptor_t descriptor;
 
-      js_env_t *env;
-      err = js_get_typed_callback_info(info, &env, nullptr);
-      assert(err == 0);
+    descriptor.version = 0;
+    descriptor.data = nullptr;
+    descriptor.attributes = js_writable | js_enumerable | js_configurable;
+    descriptor.method = nullptr;
+    descriptor.getter = nullptr;
+    descriptor.setter = nullptr;
 
-      return js_marshall_typed_value<js_type_options_t(options), R>(env, fn(env, js_unmarshall_typed_value<js_type_options_t(options), A>(env, std::move(args))...));
-    };
-  }
-};
+    err = js_create_property_key_utf8(env, reinterpret_cast<const utf8_t *>(name.data()), name.length(), &descriptor.name);
+    if (err < 0) throw err;
 
-template <typename... A, void fn(A...)>
-struct js_typed_callback_t<fn> {
-  template <js_function_options_t options>
-  static auto
-  create() {
-    return +[](typename js_type_info_t<A>::type... args, js_typed_callback_info_t *info) -> void {
-      if constexpr (options.statistics) options.statistics->event({js_function_call_t::typed});
+    js_handle_t function;
+    err = js_marshall_function<fn, options>(env, name.data(), name.length(), function);
+    if (err < 0) throw err;
 
-      fn(js_unmarshall_typed_value<A>(std::move(args))...);
-    };
-  }
-};
+    descriptor.value = static_cast<js_value_t *>(function);
 
-template <typename... A, void fn(js_env_t *, A...)>
-struct js_typed_callback_t<fn> {
-  template <js_function_options_t options>
-  static auto
-  create() {
-    if constexpr (options.scoped) {
-      return create_with_scope<options>();
-    } else {
-      return create_without_scope<options>();
-    }
+    return descriptor;
   }
 
 private:
-  template <js_function_options_t options>
-  static auto
-  create_with_scope() {
-    return +[](typename js_type_info_t<A>::type... args, js_typed_callback_info_t *info) -> void {
-      int err;
+  static js_value_t *
+  on_get(js_env_t *env, js_callback_info_t *info) {
+    int err;
 
-      if constexpr (options.statistics) options.statistics->event({js_function_call_t::typed});
+    js_value_t *receiver;
+    err = js_get_callback_info(env, info, nullptr, nullptr, &receiver, nullptr);
+    assert(err == 0);
 
-      js_env_t *env;
-      err = js_get_typed_callback_info(info, &env, nullptr);
-      assert(err == 0);
+    js_handle_t function;
+    err = js_marshall_function<fn, options>(env, name.data(), name.length(), function);
+    if (err < 0) return nullptr;
 
-      js_handle_scope_t *scope;
-      err = js_open_handle_scope(env, &scope);
-      assert(err == 0);
+    err = replace(env, receiver, static_cast<js_value_t *>(function));
+    if (err < 0) return nullptr;
 
-      try {
-        fn(env, js_unmarshall_typed_value<js_type_options_t(options), A>(env, std::move(args))...);
-      } catch (...) {
-      }
+    return static_cast<js_value_t *>(function);
+  }
+
+  static js_value_t *
+  on_set(js_env_t *env, js_callback_info_t *info) {
+    int err;
+
+    size_t argc = 1;
+    js_value_t *argv[1];
+    js_value_t *receiver;
+    err = js_get_callback_info(env, info, &argc, argv, &receiver, nullptr);
+    assert(err == 0);
 
-      err = js_close_handle_scope(env, scope);
+    if (argc == 0) {
+      err = js_get_undefined(env, &argv[0]);
       assert(err == 0);
-    };
+    }
+
+    err = replace(env, receiver, argv[0]);
+    if (err < 0) return nullptr;
+
+    return nullptr;
   }
 
-  template <js_function_options_t options>
-  static auto
-  create_without_scope() {
-    return +[](typename js_type_info_t<A>::type... args, js_typed_callback_info_t *info) -> void {
-      int err;
+  static int
+  replace(js_env_t *env, js_value_t *receiver, js_value_t *value) {
+    int err;
 
-      if constexpr (options.statistics) options.statistics->event({js_function_call_t::typed});
+    js_property_descriptor_t descriptor;
 
-      js_env_t *env;
-      err = js_get_typed_callback_info(info, &env, nullptr);
-      assert(err == 0);
+    descriptor.version = 0;
+    descriptor.data = nullptr;
+    descriptor.attributes = js_writable | js_enumerable | js_configurable;
+    descriptor.method = nullptr;
+    descriptor.getter = nullptr;
+    descriptor.setter = nullptr;
+    descriptor.value = value;
 
-      try {
-        fn(env, js_unmarshall_typed_value<js_type_options_t(options), A>(env, std::move(args))...);
-      } catch (...) {
-      }
-    };
+    err = js_create_property_key_utf8(env, reinterpret_cast<const utf8_t *>(name.data()), name.length(), &descriptor.name);
+    if (err < 0) return err;
+
+    return js_define_properties(env, receiver, &descriptor, 1);
   }
 };
 
-template <auto fn>
-struct js_untyped_callback_t;
-
-template <typename R, typename... A, R fn(A...)>
-struct js_untyped_callback_t<fn> {
-  template <js_function_options_t options>
+template <typename T>
+struct js_type_match_t {
   static auto
-  create() {
-    return create<options>(std::index_sequence_for<A...>());
-  }
+  match(js_env_t *env, js_value_t *value, bool &result) {
+    int err;
 
-private:
-  template <js_function_options_t options, size_t... I>
-  static auto
-  create(std::index_sequence<I...>) {
-    return +[](js_env_t *env, js_callback_info_t *info) -> js_value_t * {
-      int err;
+    js_value_type_t type;
+    err = js_typeof(env, value, &type);
+    if (err < 0) return err;
 
-      if constexpr (options.statistics) options.statistics->event({js_function_call_t::untyped});
+    return match(env, value, type, result);
+  }
 
-      size_t argc = sizeof...(A);
-      js_value_t *argv[sizeof...(A)];
+  static int
+  match(js_env_t *env, js_value_t *value, js_value_type_t type, bool &result) {
+    switch (js_type_info_t<T>::signature) {
+    case js_int32:
+      return match_integer(env, value, type, INT32_MIN, INT32_MAX, result);
+    case js_uint32:
+      return match_integer(env, value, type, 0, UINT32_MAX, result);
+    case js_int64:
+      return match_integer(env, value, type, js_min_safe_integer, js_max_safe_integer, result);
+    case js_uint64:
+      return match_integer(env, value, type, 0, js_max_safe_integer, result);
+    case js_float64:
+      result = type == js_number;
+      break;
+    case js_bigint64:
+    case js_biguint64:
+      result = type == js_bigint;
+      break;
+    case js_object:
+      result = type == js_object || type == js_function;
+      break;
+    default:
+      result = type == js_type_info_t<T>::signature;
+    }
 
-      if constexpr (js_argument_info_t<A...>::has_receiver) {
-        argc--;
+    return 0;
+  }
 
-        err = js_get_callback_info(env, info, &argc, &argv[1], &argv[0], nullptr);
-        assert(err == 0);
+private:
+  static int
+  match_integer(js_env_t *env, js_value_t *value, js_value_type_t type, double min, double max, bool &result) {
+    int err;
 
-        argc++;
-      } else {
-        err = js_get_callback_info(env, info, &argc, argv, nullptr, nullptr);
-        assert(err == 0);
-      }
+    if (type != js_number) {
+      result = false;
 
-      assert(argc == sizeof...(A));
+      return 0;
+    }
 
-      js_value_t *result;
+    double n, i;
+    err = js_get_value_double(env, value, &n);
+    if (err < 0) return err;
 
-      try {
-        result = js_marshall_untyped_value<js_type_options_t(options), R>(env, fn(js_unmarshall_untyped_value<js_type_options_t(options), A>(env, argv[I])...));
-      } catch (...) {
-        result = nullptr;
-      }
+    result = modf(n, &i) == 0.0 && i >= min && i <= max;
 
-      return result;
-    };
+    return 0;
   }
 };
 
-template <typename R, typename... A, R fn(js_env_t *, A...)>
-struct js_untyped_callback_t<fn> {
-  template <js_function_options_t options>
+template <>
+struct js_type_match_t<js_handle_t> {
   static auto
-  create() {
-    if constexpr (options.scoped) {
-      return create_with_scope<options>(std::index_sequence_for<A...>());
-    } else {
-      return create_without_scope<options>(std::index_sequence_for<A...>());
-    }
+  match(js_env_t *, js_value_t *, bool &result) {
+    result = true;
+
+    return 0;
   }
 
-private:
-  template <js_function_options_t options, size_t... I>
   static auto
-  create_with_scope(std::index_sequence<I...>) {
-    return +[](js_env_t *env, js_callback_info_t *info) -> js_value_t * {
-      int err;
+  match(js_env_t *, js_value_t *, js_value_type_t, bool &result) {
+    result = true;
 
-      if constexpr (options.statistics) options.statistics->event({js_function_call_t::untyped});
+    return 0;
+  }
+};
 
-      js_escapable_handle_scope_t *scope;
-      err = js_open_escapable_handle_scope(env, &scope);
-      assert(err == 0);
+template <typename T>
+struct js_type_match_t<std::optional<T>> {
+  static auto
+  match(js_env_t *env, js_value_t *value, bool &result) {
+    int err;
 
-      size_t argc = sizeof...(A);
-      js_value_t *argv[sizeof...(A)];
+    err = js_is_undefined(env, value, &result);
+    if (err < 0) return err;
 
-      if constexpr (js_argument_info_t<A...>::has_receiver) {
-        argc--;
+    if (result) return 0;
 
-        err = js_get_callback_info(env, info, &argc, &argv[1], &argv[0], nullptr);
-        assert(err == 0);
+    return js_type_match_t<T>::match(env, value, result);
+  }
 
-        argc++;
-      } else {
-        err = js_get_callback_info(env, info, &argc, argv, nullptr, nullptr);
-        assert(err == 0);
-      }
+  static auto
+  match(js_env_t *env, js_value_t *value, js_value_type_t type, bool &result) {
+    if (type == js_undefined) {
+      result = true;
 
-      assert(argc == sizeof...(A));
+      return 0;
+    }
 
-      js_value_t *result;
+    return js_type_match_t<T>::match(env, value, type, result);
+  }
+};
 
-      try {
-        result = js_marshall_untyped_value<js_type_options_t(options), R>(env, fn(env, js_unmarshall_untyped_value<js_type_options_t(options), A>(env, argv[I])...));
+template <typename T>
+struct js_object_type_match_t {
+  static auto
+  match(js_env_t *env, js_value_t *value, bool &result) {
+    return T::is(env, value, result);
+  }
 
-        err = js_escape_handle(env, scope, result, &result);
-        assert(err == 0);
-      } catch (...) {
-        result = nullptr;
-      }
+  static auto
+  match(js_env_t *env, js_value_t *value, js_value_type_t type, bool &result) {
+    if (type != js_object) {
+      result = false;
 
-      err = js_close_escapable_handle_scope(env, scope);
-      assert(err == 0);
+      return 0;
+    }
 
-      return result;
-    };
+    return T::is(env, value, result);
   }
+};
 
-  template <js_function_options_t options, size_t... I>
+template <typename T>
+struct js_type_match_t<js_typedarray_t<T>> : js_object_type_match_t<js_type_match_t<js_typedarray_t<T>>> {
   static auto
-  create_without_scope(std::index_sequence<I...>) {
-    return +[](js_env_t *env, js_callback_info_t *info) -> js_value_t * {
-      int err;
-
-      if constexpr (options.statistics) options.statistics->event({js_function_call_t::untyped});
-
-      size_t argc = sizeof...(A);
-      js_value_t *argv[sizeof...(A)];
+  is(js_env_t *env, js_value_t *value, bool &result) {
+    return js_typedarray_info_t<T>::is(env, js_handle_t(value), result);
+  }
+};
 
-      if constexpr (js_argument_info_t<A...>::has_receiver) {
-        argc--;
+template <typename T>
+struct js_type_match_t<js_typedarray_span_t<T>> : js_object_type_match_t<js_type_match_t<js_typedarray_span_t<T>>> {
+  static auto
+  is(js_env_t *env, js_value_t *value, bool &result) {
+    return js_typedarray_info_t<T>::is(env, js_handle_t(value), result);
+  }
+};
 
-        err = js_get_callback_info(env, info, &argc, &argv[1], &argv[0], nullptr);
-        assert(err == 0);
+template <typename T, size_t N>
+struct js_type_match_t<js_typedarray_span_of_t<T, N>> : js_object_type_match_t<js_type_match_t<js_typedarray_span_of_t<T, N>>> {
+  static auto
+  is(js_env_t *env, js_value_t *value, bool &result) {
+    return js_is_typedarray(env, value, &result);
+  }
+};
 
-        argc++;
-      } else {
-        err = js_get_callback_info(env, info, &argc, argv, nullptr, nullptr);
-        assert(err == 0);
-      }
+template <>
+struct js_type_match_t<js_arraybuffer_t> : js_object_type_match_t<js_type_match_t<js_arraybuffer_t>> {
+  static auto
+  is(js_env_t *env, js_value_t *value, bool &result) {
+    return js_is_arraybuffer(env, value, &result);
+  }
+};
 
-      assert(argc == sizeof...(A));
+template <>
+struct js_type_match_t<js_arraybuffer_span_t> : js_object_type_match_t<js_type_match_t<js_arraybuffer_span_t>> {
+  static auto
+  is(js_env_t *env, js_value_t *value, bool &result) {
+    return js_is_arraybuffer(env, value, &result);
+  }
+};
 
-      js_value_t *result;
+template <typename T, size_t N>
+struct js_type_match_t<js_arraybuffer_span_of_t<T, N>> : js_object_type_match_t<js_type_match_t<js_arraybuffer_span_of_t<T, N>>> {
+  static auto
+  is(js_env_t *env, js_value_t *value, bool &result) {
+    return js_is_arraybuffer(env, value, &result);
+  }
+};
 
-      try {
-        result = js_marshall_untyped_value<js_type_options_t(options), R>(env, fn(env, js_unmarshall_untyped_value<js_type_options_t(options), A>(env, argv[I])...));
-      } catch (...) {
-        result = nullptr;
-      }
+template <>
+struct js_type_match_t<js_array_t> : js_object_type_match_t<js_type_match_t<js_array_t>> {
+  static auto
+  is(js_env_t *env, js_value_t *value, bool &result) {
+    return js_is_array(env, value, &result);
+  }
+};
 
-      return result;
-    };
+template <typename T>
+struct js_type_match_t<std::vector<T>> : js_object_type_match_t<js_type_match_t<std::vector<T>>> {
+  static auto
+  is(js_env_t *env, js_value_t *value, bool &result) {
+    return js_is_array(env, value, &result);
   }
 };
 
-template <typename... A, void fn(A...)>
-struct js_untyped_callback_t<fn> {
-  template <js_function_options_t options>
+template <typename T, js_type_options_t options, uint32_t chunk>
+struct js_type_match_t<js_array_view_t<T, options, chunk>> : js_object_type_match_t<js_type_match_t<js_array_view_t<T, options, chunk>>> {
   static auto
-  create() {
-    return create<options>(std::index_sequence_for<A...>());
+  is(js_env_t *env, js_value_t *value, bool &result) {
+    return js_is_array(env, value, &result);
   }
+};
 
-private:
-  template <js_function_options_t options, size_t... I>
+template <typename T, size_t N>
+struct js_type_match_t<std::array<T, N>> : js_object_type_match_t<js_type_match_t<std::array<T, N>>> {
   static auto
-  create(std::index_sequence<I...>) {
-    return +[](js_env_t *env, js_callback_info_t *info) -> js_value_t * {
-      int err;
+  is(js_env_t *env, js_value_t *value, bool &result) {
+    return js_is_array(env, value, &result);
+  }
+};
 
-      if constexpr (options.statistics) options.statistics->event({js_function_call_t::untyped});
+template <typename... T>
+struct js_type_match_t<std::tuple<T...>> : js_object_type_match_t<js_type_match_t<std::tuple<T...>>> {
+  static auto
+  is(js_env_t *env, js_value_t *value, bool &result) {
+    return js_is_array(env, value, &result);
+  }
+};
 
-      size_t argc = sizeof...(A);
-      js_value_t *argv[sizeof...(A)];
+template <typename... T>
+struct js_type_match_t<std::variant<T...>> {
+  static auto
+  match(js_env_t *env, js_value_t *value, bool &result) {
+    int err;
 
-      if constexpr (js_argument_info_t<A...>::has_receiver) {
-        argc--;
+    js_value_type_t type;
+    err = js_typeof(env, value, &type);
+    if (err < 0) return err;
 
-        err = js_get_callback_info(env, info, &argc, &argv[1], &argv[0], nullptr);
-        assert(err == 0);
+    return match(env, value, type, result);
+  }
 
-        argc++;
-      } else {
-        err = js_get_callback_info(env, info, &argc, argv, nullptr, nullptr);
-        assert(err == 0);
-      }
+  static int
+  match(js_env_t *env, js_value_t *value, js_value_type_t type, bool &result) {
+    int err = 0;
 
-      assert(argc == sizeof...(A));
+    result = false;
 
-      try {
-        fn(js_unmarshall_untyped_value<js_type_options_t(options), A>(env, argv[I])...);
-      } catch (...) {
-      }
+    ((err = js_type_match_t<T>::match(env, value, type, result), err < 0 || result) || ...);
 
-      return js_marshall_untyped_value<js_type_options_t(options)>(env);
-    };
+    return err;
   }
 };
 
-template <typename... A, void fn(js_env_t *, A...)>
-struct js_untyped_callback_t<fn> {
-  template <js_function_options_t options>
+template <typename... T>
+struct js_type_info_t<std::variant<T...>> {
+  using type = js_value_t *;
+
+  static constexpr auto signature = js_object;
+
+  template <js_type_options_t options>
   static auto
-  create() {
-    if constexpr (options.scoped) {
-      return create_with_scope<options>(std::index_sequence_for<A...>());
-    } else {
-      return create_without_scope<options>(std::index_sequence_for<A...>());
-    }
+  marshall(js_env_t *env, std::variant<T...> &variant, js_value_t *&result) {
+    return std::visit([&]<typename U>(U &value) -> int { return js_type_info_t<U>::template marshall<options>(env, value, result); }, variant);
   }
 
-private:
-  template <js_function_options_t options, size_t... I>
-  static auto
-  create_with_scope(std::index_sequence<I...>) {
-    return +[](js_env_t *env, js_callback_info_t *info) -> js_value_t * {
-      int err;
+  template <js_type_options_t options>
+  static int
+  unmarshall(js_env_t *env, js_value_t *value, std::variant<T...> &result) {
+    int err;
 
-      if constexpr (options.statistics) options.statistics->event({js_function_call_t::untyped});
+    js_value_type_t type;
+    err = js_typeof(env, value, &type);
+    if (err < 0) return err;
 
-      js_handle_scope_t *scope;
-      err = js_open_handle_scope(env, &scope);
-      assert(err == 0);
+    bool matched;
+    err = unmarshall<options>(env, value, type, result, matched, std::index_sequence_for<T...>());
+    if (err < 0) return err;
 
-      size_t argc = sizeof...(A);
-      js_value_t *argv[sizeof...(A)];
+    if (matched) return 0;
 
-      if constexpr (js_argument_info_t<A...>::has_receiver) {
-        argc--;
+    err = js_throw_type_error(env, nullptr, "Value does not match any variant alternative");
+    assert(err == 0);
 
-        err = js_get_callback_info(env, info, &argc, &argv[1], &argv[0], nullptr);
-        assert(err == 0);
+    return js_pending_exception;
+  }
 
-        argc++;
-      } else {
-        err = js_get_callback_info(env, info, &argc, argv, nullptr, nullptr);
-        assert(err == 0);
-      }
+private:
+  template <js_type_options_t options, size_t... I>
+  static int
+  unmarshall(js_env_t *env, js_value_t *value, js_value_type_t type, std::variant<T...> &result, bool &matched, std::index_sequence<I...>) {
+    int err = 0;
 
-      assert(argc == sizeof...(A));
+    matched = false;
 
-      try {
-        fn(env, js_unmarshall_untyped_value<js_type_options_t(options), A>(env, argv[I])...);
-      } catch (...) {
-      }
+    auto select = [&]<size_t i>() {
+      using U = std::variant_alternative_t<i, std::variant<T...>>;
 
-      err = js_close_handle_scope(env, scope);
-      assert(err == 0);
+      err = js_type_match_t<U>::match(env, value, type, matched);
+      if (err < 0) return true;
 
-      return js_marshall_untyped_value<js_type_options_t(options)>(env);
+      if (!matched) return false;
+
+      U unmarshalled;
+      err = js_type_info_t<U>::template unmarshall<options>(env, value, unmarshalled);
+      if (err < 0) return true;
+
+      result.template emplace<i>(std::move(unmarshalled));
+
+      return true;
     };
-  }
 
-  template <js_function_options_t options, size_t... I>
-  static auto
-  create_without_scope(std::index_sequence<I...>) {
-    return +[](js_env_t *env, js_callback_info_t *info) -> js_value_t * {
-      int err;
+    (select.template operator()<I>() || ...);
 
-      if constexpr (options.statistics) options.statistics->event({js_function_call_t::untyped});
+    return err;
+  }
+};
 
-      size_t argc = sizeof...(A);
-      js_value_t *argv[sizeof...(A)];
+template <typename... A>
+struct js_overload_args_t {
+  static constexpr size_t arity = sizeof...(A);
 
-      if constexpr (js_argument_info_t<A...>::has_receiver) {
-        argc--;
+  static constexpr bool has_receiver = false;
 
-        err = js_get_callback_info(env, info, &argc, &argv[1], &argv[0], nullptr);
-        assert(err == 0);
+  static auto
+  match(js_env_t *env, js_value_t *const argv[], bool &result) {
+    return match(env, argv, result, std::index_sequence_for<A...>());
+  }
 
-        argc++;
-      } else {
-        err = js_get_callback_info(env, info, &argc, argv, nullptr, nullptr);
-        assert(err == 0);
-      }
+private:
+  template <size_t... I>
+  static auto
+  match(js_env_t *env, js_value_t *const argv[], bool &result, std::index_sequence<I...>) {
+    int err = 0;
 
-      assert(argc == sizeof...(A));
+    bool matches = true;
 
-      try {
-        fn(env, js_unmarshall_untyped_value<js_type_options_t(options), A>(env, argv[I])...);
-      } catch (...) {
-      }
+    result = (... && ((err = js_type_match_t<A>::match(env, argv[I], matches)) == 0 && matches));
 
-      return js_marshall_untyped_value<js_type_options_t(options)>(env);
-    };
+    return err;
   }
 };
 
-template <auto fn, js_function_options_t options = js_function_options_t()>
-static inline auto
-js_create_typed_callback() {
-  return js_typed_callback_t<fn>::template create<options>();
-}
-
-template <auto fn, js_function_options_t options = js_function_options_t()>
-static inline auto
-js_create_untyped_callback() {
-  return js_untyped_callback_t<fn>::template create<options>();
-}
+template <typename... A>
+struct js_overload_args_t<js_receiver_t, A...> : js_overload_args_t<A...> {
+  static constexpr bool has_receiver = true;
+};
 
 template <auto fn>
-struct js_function_info_t;
+struct js_overload_info_t;
 
 template <typename R, typename... A, R fn(A...)>
-struct js_function_info_t<fn> {
-  using type = js_function_t<R, A...>;
-
-  template <js_function_options_t options>
-  static auto
-  marshall(js_env_t *env, const char *name, size_t len, js_function_t<R, A...> &result) {
-    auto typed = js_create_typed_callback<fn, options>();
+struct js_overload_info_t<fn> : js_overload_args_t<A...> {};
 
-    auto untyped = js_create_untyped_callback<fn, options>();
-
-    js_callback_signature_t signature;
+template <typename R, typename... A, R fn(js_env_t *, A...)>
+struct js_overload_info_t<fn> : js_overload_args_t<A...> {};
 
-    int args[] = {
-      js_type_info_t<A>::signature...
-    };
+template <auto... fns>
+struct js_overload_set_t {
+  static constexpr size_t max_arity = std::max({js_overload_info_t<fns>::arity...});
 
-    signature.version = 0;
-    signature.result = js_type_info_t<R>::signature;
-    signature.args_len = sizeof...(A);
-    signature.args = args;
+  template <js_function_options_t options, typename T>
+  static auto
+  marshall(js_env_t *env, const char *name, size_t len, T &result) {
+    auto callback = create<options>();
 
-    return js_create_typed_function(env, name, len, untyped, &signature, reinterpret_cast<const void *>(typed), nullptr, static_cast<js_value_t **>(result));
+    return js_create_function(env, name, len, callback, nullptr, static_cast<js_value_t **>(result));
   }
 
   template <js_function_options_t options>
   static auto
-  marshall(js_env_t *env, const char *name, size_t len, js_handle_t &result) {
-    int err;
+  create() {
+    return +[](js_env_t *env, js_callback_info_t *info) -> js_value_t * {
+      int err;
 
-    js_function_t<R, A...> value;
-    err = marshall<options>(env, name, len, value);
-    if (err < 0) return err;
+      size_t argc = max_arity;
+      js_value_t *argv[max_arity + 1];
+      err = js_get_callback_info(env, info, &argc, &argv[1], &argv[0], nullptr);
+      assert(err == 0);
 
-    result = value;
+      auto arity = std::min(argc, max_arity);
 
-    return 0;
-  }
-};
+      while (true) {
+        bool called = false;
 
-template <typename R, typename... A, R fn(js_env_t *, A...)>
-struct js_function_info_t<fn> {
-  using type = js_function_t<R, A...>;
+        js_value_t *result = nullptr;
 
-  template <js_function_options_t options>
-  static auto
-  marshall(js_env_t *env, const char *name, size_t len, js_function_t<R, A...> &result) {
-    auto typed = js_create_typed_callback<fn, options>();
+        err = 0;
 
-    auto untyped = js_create_untyped_callback<fn, options>();
+        (... || ((err = call<fns, options>(env, arity, argv, called, result)) < 0 || called));
 
-    js_callback_signature_t signature;
+        if (err < 0) return nullptr;
 
-    int args[] = {
-      js_type_info_t<A>::signature...
-    };
+        if (called) return result;
 
-    signature.version = 0;
-    signature.result = js_type_info_t<R>::signature;
-    signature.args_len = sizeof...(A);
-    signature.args = args;
+        if (arity == 0) break;
+
+        arity--;
+      }
+
+      err = js_throw_type_error(env, nullptr, "No overload matches the arguments");
+      assert(err == 0);
 
-    return js_create_typed_function(env, name, len, untyped, &signature, reinterpret_cast<const void *>(typed), nullptr, static_cast<js_value_t **>(result));
+      return nullptr;
+    };
   }
 
-  template <js_function_options_t options>
-  static auto
-  marshall(js_env_t *env, const char *name, size_t len, js_handle_t &result) {
+private:
+  template <auto fn, js_function_options_t options>
+  static int
+  call(js_env_t *env, size_t arity, js_value_t *const argv[], bool &called, js_value_t *&result) {
     int err;
 
-    js_function_t<R, A...> value;
-    err = marshall<options>(env, name, len, value);
+    using info = js_overload_info_t<fn>;
+
+    if (arity != info::arity) return 0;
+
+    bool matches;
+    err = info::match(env, &argv[1], matches);
     if (err < 0) return err;
 
-    result = value;
+    if (!matches) return 0;
+
+    called = true;
+
+    if constexpr (info::has_receiver) {
+      result = js_untyped_callback_t<fn>::template call<options>(env, argv);
+    } else {
+      result = js_untyped_callback_t<fn>::template call<options>(env, &argv[1]);
+    }
 
     return 0;
   }
@@ -3776,37 +6320,141 @@ struct js_teardown_callback_info_t<fn, T> {
 template <auto fn, js_function_options_t options = js_function_options_t()>
 static inline auto
 js_create_function(js_env_t *env, const char *name, size_t len, typename js_function_info_t<fn>::type &result) {
-  return js_function_info_t<fn>::template marshall<options>(env, name, len, result);
+  return js_marshall_function<fn, options>(env, name, len, result);
 }
 
 template <auto fn, js_function_options_t options = js_function_options_t()>
 static inline auto
 js_create_function(js_env_t *env, const std::string &name, typename js_function_info_t<fn>::type &result) {
-  return js_function_info_t<fn>::template marshall<options>(env, name.data(), name.size(), result);
+  return js_marshall_function<fn, options>(env, name.data(), name.size(), result);
 }
 
 template <auto fn, js_function_options_t options = js_function_options_t()>
 static inline auto
 js_create_function(js_env_t *env, typename js_function_info_t<fn>::type &result) {
-  return js_function_info_t<fn>::template marshall<options>(env, nullptr, 0, result);
+  return js_marshall_function<fn, options>(env, nullptr, 0, result);
 }
 
 template <auto fn, js_function_options_t options = js_function_options_t()>
 static inline auto
 js_create_function(js_env_t *env, const char *name, size_t len, js_handle_t &result) {
-  return js_function_info_t<fn>::template marshall<options>(env, name, len, result);
+  return js_marshall_function<fn, options>(env, name, len, result);
 }
 
 template <auto fn, js_function_options_t options = js_function_options_t()>
 static inline auto
 js_create_function(js_env_t *env, std::string name, js_handle_t &result) {
-  return js_function_info_t<fn>::template marshall<options>(env, name.data(), name.length(), result);
+  return js_marshall_function<fn, options>(env, name.data(), name.length(), result);
 }
 
 template <auto fn, js_function_options_t options = js_function_options_t()>
 static inline auto
 js_create_function(js_env_t *env, js_handle_t &result) {
-  return js_function_info_t<fn>::template marshall<options>(env, nullptr, 0, result);
+  return js_marshall_function<fn, options>(env, nullptr, 0, result);
+}
+
+template <js_function_options_t options, auto fn1, auto fn2, auto... fns>
+  requires std::is_function_v<std::remove_pointer_t<decltype(fn1)>> && std::is_function_v<std::remove_pointer_t<decltype(fn2)>>
+static inline auto
+js_create_function(js_env_t *env, const char *name, size_t len, js_handle_t &result) {
+  return js_marshall_function<js_overload_set_t<fn1, fn2, fns...>, options>(env, name, len, result);
+}
+
+template <js_function_options_t options, auto fn1, auto fn2, auto... fns>
+  requires std::is_function_v<std::remove_pointer_t<decltype(fn1)>> && std::is_function_v<std::remove_pointer_t<decltype(fn2)>>
+static inline auto
+js_create_function(js_env_t *env, const std::string &name, js_handle_t &result) {
+  return js_create_function<options, fn1, fn2, fns...>(env, name.data(), name.length(), result);
+}
+
+template <js_function_options_t options, auto fn1, auto fn2, auto... fns>
+  requires std::is_function_v<std::remove_pointer_t<decltype(fn1)>> && std::is_function_v<std::remove_pointer_t<decltype(fn2)>>
+static inline auto
+js_create_function(js_env_t *env, js_handle_t &result) {
+  return js_create_function<options, fn1, fn2, fns...>(env, nullptr, 0, result);
+}
+
+template <auto fn1, auto fn2, auto... fns>
+  requires std::is_function_v<std::remove_pointer_t<decltype(fn1)>> && std::is_function_v<std::remove_pointer_t<decltype(fn2)>>
+static inline auto
+js_create_function(js_env_t *env, const char *name, size_t len, js_handle_t &result) {
+  return js_create_function<js_function_options_t{}, fn1, fn2, fns...>(env, name, len, result);
+}
+
+template <auto fn1, auto fn2, auto... fns>
+  requires std::is_function_v<std::remove_pointer_t<decltype(fn1)>> && std::is_function_v<std::remove_pointer_t<decltype(fn2)>>
+static inline auto
+js_create_function(js_env_t *env, const std::string &name, js_handle_t &result) {
+  return js_create_function<js_function_options_t{}, fn1, fn2, fns...>(env, name.data(), name.length(), result);
+}
+
+template <auto fn1, auto fn2, auto... fns>
+  requires std::is_function_v<std::remove_pointer_t<decltype(fn1)>> && std::is_function_v<std::remove_pointer_t<decltype(fn2)>>
+static inline auto
+js_create_function(js_env_t *env, js_handle_t &result) {
+  return js_create_function<js_function_options_t{}, fn1, fn2, fns...>(env, nullptr, 0, result);
+}
+
+template <auto fn, js_function_options_t options = js_function_options_t(), typename T>
+static inline auto
+js_create_function(js_env_t *env, const char *name, size_t len, T *data, typename js_closure_info_t<fn>::type &result) {
+  return js_closure_info_t<fn>::template marshall<options>(env, name, len, data, result);
+}
+
+template <auto fn, js_function_options_t options = js_function_options_t(), typename T>
+static inline auto
+js_create_function(js_env_t *env, const std::string &name, T *data, typename js_closure_info_t<fn>::type &result) {
+  return js_closure_info_t<fn>::template marshall<options>(env, name.data(), name.length(), data, result);
+}
+
+template <auto fn, js_function_options_t options = js_function_options_t(), typename T>
+static inline auto
+js_create_function(js_env_t *env, T *data, typename js_closure_info_t<fn>::type &result) {
+  return js_closure_info_t<fn>::template marshall<options>(env, nullptr, 0, data, result);
+}
+
+template <js_function_options_t options = js_function_options_t(), typename F>
+static inline auto
+js_create_function(js_env_t *env, const char *name, size_t len, F &&fn, typename js_callable_info_t<std::decay_t<F>>::type &result) {
+  int err;
+
+  using callable_t = std::decay_t<F>;
+
+  auto callable = new callable_t(std::forward<F>(fn));
+
+  err = js_closure_info_t<js_callable_info_t<callable_t>::call>::template marshall<options>(env, name, len, callable, result);
+
+  if (err < 0) {
+    delete callable;
+
+    return err;
+  }
+
+  auto finalize = +[](js_env_t *, void *data, void *) {
+    delete reinterpret_cast<callable_t *>(data);
+  };
+
+  err = js_add_finalizer(env, static_cast<js_value_t *>(result), reinterpret_cast<void *>(callable), finalize, nullptr, nullptr);
+
+  if (err < 0) {
+    delete callable;
+
+    return err;
+  }
+
+  return 0;
+}
+
+template <js_function_options_t options = js_function_options_t(), typename F>
+static inline auto
+js_create_function(js_env_t *env, const std::string &name, F &&fn, typename js_callable_info_t<std::decay_t<F>>::type &result) {
+  return js_create_function<options>(env, name.data(), name.length(), std::forward<F>(fn), result);
+}
+
+template <js_function_options_t options = js_function_options_t(), typename F>
+static inline auto
+js_create_function(js_env_t *env, F &&fn, typename js_callable_info_t<std::decay_t<F>>::type &result) {
+  return js_create_function<options>(env, nullptr, 0, std::forward<F>(fn), result);
 }
 
 template <js_type_options_t options = js_type_options_t(), typename... A>
@@ -3956,6 +6604,22 @@ js_create_object(js_env_t *env, js_object_t &result, const js_property_t<T>... p
   return js_define_properties(env, result, properties...);
 }
 
+template <js_string_literal_t... names, typename... T>
+static inline auto
+js_create_object(js_env_t *env, js_object_t &result, const js_literal_property_t<names, T>... properties) {
+  int err;
+  err = js_create_object(env, result);
+  if (err < 0) return err;
+
+  return js_define_properties(env, result, properties...);
+}
+
+template <size_t N>
+static inline auto
+js_create_property_key(js_env_t *env, const js_string_literal_t<N> &name, js_string_t &result) {
+  return js_create_property_key_utf8(env, reinterpret_cast<const utf8_t *>(name.data()), name.length(), static_cast<js_value_t **>(result));
+}
+
 static inline auto
 js_create_array(js_env_t *env, js_array_t &result) {
   return js_create_array(env, static_cast<js_value_t **>(result));
@@ -4147,6 +6811,63 @@ js_create_external_arraybuffer(js_env_t *env, T *data, size_t len, U *finalize_h
   return js_create_external_arraybuffer(env, reinterpret_cast<void *>(data), len * sizeof(T), js_create_finalizer<finalize, T, U>(), reinterpret_cast<void *>(finalize_hint), static_cast<js_value_t **>(result));
 }
 
+static inline auto
+js_create_external_arraybuffer(js_env_t *env, const js_growable_buffer_t &buffer, js_arraybuffer_t &result) {
+  return js_type_info_t<js_growable_buffer_t>::marshall<js_type_options_t{}>(env, buffer, *static_cast<js_value_t **>(result));
+}
+
+static inline auto
+js_create_external_arraybuffer(js_env_t *env, js_mapped_file_t &file, js_arraybuffer_t &result) {
+  return js_type_info_t<js_mapped_file_t>::marshall<js_type_options_t{}>(env, file, *static_cast<js_value_t **>(result));
+}
+
+static inline int
+js_create_mapped_arraybuffer(js_env_t *env, const char *path, uint64_t offset, size_t len, js_mapped_file_advice_t advice, js_arraybuffer_t &result) {
+  int err;
+
+  js_mapped_file_t file;
+  err = file.open(path, offset, len, advice);
+
+  if (err < 0) {
+    err = js_throw_error(env, uv_err_name(err), uv_strerror(err));
+    assert(err == 0);
+
+    return js_pending_exception;
+  }
+
+  return js_create_external_arraybuffer(env, file, result);
+}
+
+static inline auto
+js_create_mapped_arraybuffer(js_env_t *env, const char *path, uint64_t offset, size_t len, js_arraybuffer_t &result) {
+  return js_create_mapped_arraybuffer(env, path, offset, len, js_mapped_file_normal, result);
+}
+
+static inline auto
+js_create_mapped_arraybuffer(js_env_t *env, const char *path, js_arraybuffer_t &result) {
+  return js_create_mapped_arraybuffer(env, path, 0, size_t(-1), js_mapped_file_normal, result);
+}
+
+template <typename T>
+static inline auto
+js_create_arraybuffer(js_env_t *env, js_arraybuffer_pool_t &pool, size_t len, T *&data, js_arraybuffer_t &result) {
+  int err;
+
+  uint8_t *block;
+  err = pool.create(env, len * sizeof(T), block, result);
+  if (err < 0) return err;
+
+  data = reinterpret_cast<T *>(block);
+
+  return 0;
+}
+
+static inline auto
+js_create_arraybuffer(js_env_t *env, js_arraybuffer_pool_t &pool, size_t len, js_arraybuffer_t &result) {
+  uint8_t *data;
+  return js_create_arraybuffer(env, pool, len, data, result);
+}
+
 static inline auto
 js_detach_arraybuffer(js_env_t *env, const js_arraybuffer_t &arraybuffer) {
   return js_detach_arraybuffer(env, static_cast<js_value_t *>(arraybuffer));
@@ -4397,6 +7118,48 @@ js_create_typedarray(js_env_t *env, const std::vector<T> &data, js_typedarray_t<
   return 0;
 }
 
+template <js_typedarray_element T, std::ranges::input_range R>
+  requires js_is_same<std::ranges::range_value_t<R>, T> && (std::ranges::sized_range<R> || std::ranges::forward_range<R>)
+static inline auto
+js_create_typedarray(js_env_t *env, R &&data, js_typedarray_t<T> &result) {
+  int err;
+
+  size_t len = std::ranges::distance(data);
+
+  T *view;
+  err = js_create_typedarray(env, len, view, result);
+  if (err < 0) return err;
+
+  std::ranges::copy(data, view);
+
+  return 0;
+}
+
+template <js_typedarray_element T>
+static inline auto
+js_create_typedarray(js_env_t *env, const js_growable_buffer_t &buffer, js_typedarray_t<T> &result) {
+  int err;
+
+  assert(buffer.size() % sizeof(T) == 0);
+
+  js_arraybuffer_t arraybuffer;
+  err = js_create_external_arraybuffer(env, buffer, arraybuffer);
+  if (err < 0) return err;
+
+  return js_create_typedarray(env, buffer.size() / sizeof(T), arraybuffer, result);
+}
+
+static inline auto
+js_create_typedarray(js_env_t *env, const js_growable_buffer_t &buffer, js_typedarray_t<> &result) {
+  int err;
+
+  js_arraybuffer_t arraybuffer;
+  err = js_create_external_arraybuffer(env, buffer, arraybuffer);
+  if (err < 0) return err;
+
+  return js_create_typedarray(env, buffer.size(), arraybuffer, result);
+}
+
 template <typename T>
 static inline auto
 js_get_arraybuffer_info(js_env_t *env, const js_arraybuffer_t &arraybuffer, T *&data, size_t &len) {
@@ -4743,13 +7506,81 @@ js_set_property(js_env_t *env, js_value_t *object, const std::string &name, T va
   return js_set_property<options>(env, object, name.c_str(), value);
 }
 
+template <js_type_options_t options = js_type_options_t(), typename T>
+static inline int
+js_get_property(js_env_t *env, js_value_t *object, js_value_t *key, T &result) {
+  int err;
+
+  js_value_t *value;
+  err = js_get_property(env, object, key, &value);
+  if (err < 0) return err;
+
+  return js_type_info_t<T>::template unmarshall<options>(env, value, result);
+}
+
+template <js_type_options_t options, js_string_literal_t... names, typename... T>
+  requires(sizeof...(names) == sizeof...(T))
+static inline int
+js_get_properties(js_env_t *env, const js_object_t &object, T &...results) {
+  int err = 0;
+
+  auto get = [&]<js_string_literal_t name>(auto &result) {
+    js_value_t *key;
+    err = js_property_key_t<name>::get(env, key);
+    if (err < 0) return false;
+
+    err = js_get_property<options>(env, static_cast<js_value_t *>(object), key, result);
+    if (err < 0) return false;
+
+    return true;
+  };
+
+  (get.template operator()<names>(results) && ...);
+
+  return err;
+}
+
+template <js_string_literal_t... names, typename... T>
+  requires(sizeof...(names) == sizeof...(T))
+static inline int
+js_get_properties(js_env_t *env, const js_object_t &object, T &...results) {
+  return js_get_properties<js_type_options_t{}, names...>(env, object, results...);
+}
+
+template <js_type_options_t options = js_type_options_t(), js_string_literal_t... names, typename... T>
+static inline int
+js_get_properties(js_env_t *env, const js_object_t &object, const js_object_shape_t<names...> &shape, T &...results) {
+  static_assert(sizeof...(names) == sizeof...(T), "Shape and result count must match");
+
+  int err = 0;
+
+  const auto &keys = shape.keys();
+
+  size_t i = 0;
+
+  auto get = [&](auto &result) {
+    js_value_t *key;
+    err = js_get_reference_value(env, static_cast<js_ref_t *>(keys[i++]), &key);
+    if (err < 0) return false;
+
+    err = js_get_property<options>(env, static_cast<js_value_t *>(object), key, result);
+    if (err < 0) return false;
+
+    return true;
+  };
+
+  (get(results) && ...);
+
+  return err;
+}
+
 template <auto fn, js_function_options_t options = js_function_options_t()>
 static inline auto
 js_set_property(js_env_t *env, const js_object_t &object, const js_name_t &name) {
   int err;
 
   js_handle_t value;
-  err = js_function_info_t<fn>::template marshall<options>(env, nullptr, 0, value);
+  err = js_marshall_function<fn, options>(env, nullptr, 0, value);
   if (err < 0) return err;
 
   return js_set_property(env, object, name, value);
@@ -4761,7 +7592,7 @@ js_set_property(js_env_t *env, const js_object_t &object, const char *name) {
   int err;
 
   js_handle_t value;
-  err = js_function_info_t<fn>::template marshall<options>(env, name, size_t(-1), value);
+  err = js_marshall_function<fn, options>(env, name, size_t(-1), value);
   if (err < 0) return err;
 
   return js_set_named_property(env, static_cast<js_value_t *>(object), name, static_cast<js_value_t *>(value));
@@ -4855,7 +7686,7 @@ js_set_element(js_env_t *env, const js_object_t &object, uint32_t index) {
   int err;
 
   js_handle_t value;
-  err = js_function_info_t<fn>::template marshall<options>(env, nullptr, 0, value);
+  err = js_marshall_function<fn, options>(env, nullptr, 0, value);
   if (err < 0) return err;
 
   return js_set_element(env, object, index, value);
@@ -4936,6 +7767,45 @@ js_get_array_elements(js_env_t *env, const js_array_t &array, std::vector<T> &re
   return 0;
 }
 
+template <typename T, uint32_t chunk = 256, js_type_options_t options = js_type_options_t(), typename F>
+static inline int
+js_for_each_element(js_env_t *env, const js_array_t &array, F &&fn) {
+  static_assert(chunk > 0);
+
+  int err;
+
+  uint32_t len;
+  err = js_get_array_length(env, static_cast<js_value_t *>(array), &len);
+  if (err < 0) return err;
+
+  js_value_t *elements[chunk];
+
+  for (uint32_t offset = 0; offset < len; offset += chunk) {
+    js_scope_t scope(env);
+
+    uint32_t count;
+    err = js_get_array_elements(env, static_cast<js_value_t *>(array), elements, chunk, offset, &count);
+    if (err < 0) return err;
+
+    for (uint32_t i = 0; i < count; i++) {
+      T value;
+      err = js_type_info_t<T>::template unmarshall<options>(env, elements[i], value);
+      if (err < 0) return err;
+
+      if constexpr (std::is_void_v<std::invoke_result_t<F &, T &&>>) {
+        fn(std::move(value));
+      } else {
+        err = fn(std::move(value));
+        if (err < 0) return err;
+      }
+    }
+
+    if (count < chunk) break;
+  }
+
+  return 0;
+}
+
 template <js_type_options_t options = js_type_options_t(), typename... T, size_t... I>
 static inline auto
 js_get_array_elements(js_env_t *env, const js_array_t &array, std::tuple<T...> &result, std::index_sequence<I...>) {
@@ -5059,6 +7929,120 @@ js_create_property_descriptor(js_env_t *env, const js_property_t<T> &property, j
   return 0;
 }
 
+template <js_type_options_t options = js_type_options_t(), js_string_literal_t name, typename T>
+static inline auto
+js_create_property_descriptor(js_env_t *env, const js_literal_property_t<name, T> &property, js_property_descriptor_t &result) {
+  int err;
+
+  js_property_descriptor_t descriptor;
+
+  descriptor.version = 0;
+  descriptor.data = nullptr;
+  descriptor.attributes = js_writable | js_enumerable | js_configurable;
+  descriptor.method = nullptr;
+  descriptor.getter = nullptr;
+  descriptor.setter = nullptr;
+
+  err = js_property_key_t<name>::get(env, descriptor.name);
+  if (err < 0) return err;
+
+  err = js_type_info_t<T>::template marshall<options>(env, property.value(), descriptor.value);
+  if (err < 0) return err;
+
+  result = descriptor;
+
+  return 0;
+}
+
+template <js_type_options_t options = js_type_options_t(), auto fn, js_function_options_t function_options>
+static inline auto
+js_create_property_descriptor(js_env_t *env, const js_property_t<js_method_t<fn, function_options>> &property, js_property_descriptor_t &result) {
+  int err;
+
+  js_property_descriptor_t descriptor;
+
+  descriptor.version = 0;
+  descriptor.data = nullptr;
+  descriptor.attributes = js_writable | js_configurable;
+  descriptor.method = nullptr;
+  descriptor.getter = nullptr;
+  descriptor.setter = nullptr;
+
+  const auto &name = property.name();
+
+  err = js_create_string_utf8(env, reinterpret_cast<const utf8_t *>(name.data()), name.length(), &descriptor.name);
+  if (err < 0) return err;
+
+  js_handle_t value;
+  err = js_function_info_t<js_method_info_t<fn>::call>::template marshall<function_options>(env, name.data(), name.length(), value);
+  if (err < 0) return err;
+
+  descriptor.value = static_cast<js_value_t *>(value);
+
+  result = descriptor;
+
+  return 0;
+}
+
+template <js_type_options_t options = js_type_options_t(), auto fn, js_function_options_t function_options>
+static inline auto
+js_create_property_descriptor(js_env_t *env, const js_property_t<js_static_method_t<fn, function_options>> &property, js_property_descriptor_t &result) {
+  int err;
+
+  js_property_descriptor_t descriptor;
+
+  descriptor.version = 0;
+  descriptor.data = nullptr;
+  descriptor.attributes = js_writable | js_configurable | js_static;
+  descriptor.method = nullptr;
+  descriptor.getter = nullptr;
+  descriptor.setter = nullptr;
+
+  const auto &name = property.name();
+
+  err = js_create_string_utf8(env, reinterpret_cast<const utf8_t *>(name.data()), name.length(), &descriptor.name);
+  if (err < 0) return err;
+
+  js_handle_t value;
+  err = js_function_info_t<fn>::template marshall<function_options>(env, name.data(), name.length(), value);
+  if (err < 0) return err;
+
+  descriptor.value = static_cast<js_value_t *>(value);
+
+  result = descriptor;
+
+  return 0;
+}
+
+template <js_type_options_t options = js_type_options_t(), auto get, auto set, js_function_options_t function_options>
+static inline auto
+js_create_property_descriptor(js_env_t *env, const js_property_t<js_accessor_t<get, set, function_options>> &property, js_property_descriptor_t &result) {
+  int err;
+
+  js_property_descriptor_t descriptor;
+
+  descriptor.version = 0;
+  descriptor.data = nullptr;
+  descriptor.attributes = js_configurable;
+  descriptor.method = nullptr;
+  descriptor.getter = js_create_untyped_callback<js_method_info_t<get>::call, function_options>();
+  descriptor.setter = nullptr;
+  descriptor.value = nullptr;
+
+  if constexpr (!js_is_same<decltype(set), std::nullptr_t>) {
+    descriptor.setter = js_create_untyped_callback<js_method_info_t<set>::call, function_options>();
+  }
+
+  const auto &name = property.name();
+
+  err = js_create_string_utf8(env, reinterpret_cast<const utf8_t *>(name.data()), name.length(), &descriptor.name);
+  if (err < 0) return err;
+
+  result = descriptor;
+
+  return 0;
+}
+
 template <js_type_options_t options = js_type_options_t(), typename T>
 static inline auto
 js_create_property_descriptor(js_env_t *env, const js_property_t<T> &property) {
@@ -5071,6 +8055,18 @@ js_create_property_descriptor(js_env_t *env, const js_property_t<T> &property) {
   return descriptor;
 }
 
+template <js_type_options_t options = js_type_options_t(), js_string_literal_t name, typename T>
+static inline auto
+js_create_property_descriptor(js_env_t *env, const js_literal_property_t<name, T> &property) {
+  int err;
+
+  js_property_descriptor_t descriptor;
+  err = js_create_property_descriptor<options>(env, property, descriptor);
+  if (err < 0) throw err;
+
+  return descriptor;
+}
+
 template <js_type_options_t options = js_type_options_t(), typename... T>
 static inline auto
 js_define_properties(js_env_t *env, const js_object_t &object, const js_property_t<T>... properties) {
@@ -5085,49 +8081,290 @@ js_define_properties(js_env_t *env, const js_object_t &object, const js_property
   }
 }
 
+template <js_type_options_t options = js_type_options_t(), js_string_literal_t... names, typename... T>
+static inline auto
+js_define_properties(js_env_t *env, const js_object_t &object, const js_literal_property_t<names, T>... properties) {
+  try {
+    js_property_descriptor_t descriptors[] = {
+      js_create_property_descriptor<options>(env, properties)...
+    };
+
+    return js_define_properties(env, static_cast<js_value_t *>(object), descriptors, sizeof...(T));
+  } catch (int err) {
+    return err;
+  }
+}
+
+template <typename... T>
+static inline auto
+js_define_lazy_exports(js_env_t *env, const js_object_t &exports) {
+  static_assert(sizeof...(T) > 0, "Exports must have at least one entry");
+
+  try {
+    js_property_descriptor_t descriptors[] = {
+      js_export_info_t<T>::lazy_descriptor(env)...
+    };
+
+    return js_define_properties(env, static_cast<js_value_t *>(exports), descriptors, sizeof...(T));
+  } catch (int err) {
+    return err;
+  }
+}
+
+template <typename... T>
+static inline auto
+js_define_lazy_exports(js_env_t *env, js_value_t *exports) {
+  return js_define_lazy_exports<T...>(env, js_object_t(exports));
+}
+
+template <typename... T>
+struct js_exports_t {
+  static_assert(sizeof...(T) > 0, "Exports must have at least one entry");
+
+  static constexpr size_t length = sizeof...(T);
+
+  static int
+  define(js_env_t *env, const js_object_t &exports) {
+    try {
+      js_property_descriptor_t descriptors[] = {
+        js_export_info_t<T>::descriptor(env)...
+      };
+
+      return js_define_properties(env, static_cast<js_value_t *>(exports), descriptors, length);
+    } catch (int err) {
+      return err;
+    }
+  }
+
+  static int
+  define(js_env_t *env, js_value_t *exports) {
+    return define(env, js_object_t(exports));
+  }
+
+  static int
+  define_lazy(js_env_t *env, const js_object_t &exports) {
+    return js_define_lazy_exports<T...>(env, exports);
+  }
+
+  static int
+  define_lazy(js_env_t *env, js_value_t *exports) {
+    return js_define_lazy_exports<T...>(env, exports);
+  }
+};
+
+template <auto constructor, js_function_options_t options, typename... T>
+struct js_class_cache_t {
+  static inline js_env_local_t<js_persistent_t<js_object_t>> constructor_;
+};
+
+template <auto constructor, js_function_options_t options = js_function_options_t(), typename... T>
+static inline int
+js_define_class(js_env_t *env, const std::string &name, js_object_t &result, const js_property_t<T>... properties) {
+  int err;
+
+  if constexpr (options.cached) {
+    auto &cached = js_class_cache_t<constructor, options, T...>::constructor_.get(env);
+
+    if (cached) return js_get_reference_value(env, cached, result);
+  }
+
+  auto callback = js_constructor_info_t<constructor>::template create<options>();
+
+  if constexpr (sizeof...(T) == 0) {
+    err = js_define_class(env, name.data(), name.length(), callback, nullptr, nullptr, 0, static_cast<js_value_t **>(result));
+    if (err < 0) return err;
+  } else {
+    try {
+      js_property_descriptor_t descriptors[] = {
+        js_create_property_descriptor<js_type_options_t(options)>(env, properties)...
+      };
+
+      err = js_define_class(env, name.data(), name.length(), callback, nullptr, descriptors, sizeof...(T), static_cast<js_value_t **>(result));
+      if (err < 0) return err;
+    } catch (int err) {
+      return err;
+    }
+  }
+
+  if constexpr (options.cached) {
+    return js_create_reference(env, result, js_class_cache_t<constructor, options, T...>::constructor_.get(env));
+  }
+
+  return 0;
+}
+
+static inline auto
+js_run_script(js_env_t *env, const char *file, size_t len, int offset, const js_string_t &source, js_handle_t &result) {
+  return js_run_script(env, file, len, offset, static_cast<js_value_t *>(source), static_cast<js_value_t **>(result));
+}
+
+static inline auto
+js_run_script(js_env_t *env, const std::string &file, int offset, const js_string_t &source, js_handle_t &result) {
+  return js_run_script(env, file.data(), file.length(), offset, static_cast<js_value_t *>(source), static_cast<js_value_t **>(result));
+}
+
+static inline auto
+js_run_script(js_env_t *env, const js_string_t &source, js_handle_t &result) {
+  return js_run_script(env, nullptr, 0, 0, static_cast<js_value_t *>(source), static_cast<js_value_t **>(result));
+}
+
+template <typename T>
+static inline auto
+js_create_reference(js_env_t *env, const T &value, js_persistent_t<T> &result) {
+  int err;
+
+  js_ref_t *ref;
+  err = js_create_reference(env, static_cast<js_value_t *>(value), 1, &ref);
+  if (err < 0) return err;
+
+  result = js_persistent_t<T>(env, ref);
+
+  return 0;
+}
+
+template <typename T>
+static inline auto
+js_get_reference_value(js_env_t *env, const js_persistent_t<T> &reference, T &result) {
+  int err;
+
+  js_value_t *value;
+  err = js_get_reference_value(env, static_cast<js_ref_t *>(reference), &value);
+  if (err < 0) return err;
+
+  result = T(value);
+
+  return 0;
+}
+
+template <typename T>
+static inline auto
+js_create_reference(js_env_t *env, const T &value, js_weak_t<T> &result) {
+  int err;
+
+  js_ref_t *ref;
+  err = js_create_reference(env, static_cast<js_value_t *>(value), 0, &ref);
+  if (err < 0) return err;
+
+  result = js_weak_t<T>(env, ref);
+
+  return 0;
+}
+
+template <typename T>
 static inline auto
-js_run_script(js_env_t *env, const char *file, size_t len, int offset, const js_string_t &source, js_handle_t &result) {
-  return js_run_script(env, file, len, offset, static_cast<js_value_t *>(source), static_cast<js_value_t **>(result));
-}
+js_get_reference_value(js_env_t *env, const js_weak_t<T> &reference, std::optional<T> &result) {
+  int err;
 
-static inline auto
-js_run_script(js_env_t *env, const std::string &file, int offset, const js_string_t &source, js_handle_t &result) {
-  return js_run_script(env, file.data(), file.length(), offset, static_cast<js_value_t *>(source), static_cast<js_value_t **>(result));
-}
+  js_value_t *value;
+  err = js_get_reference_value(env, static_cast<js_ref_t *>(reference), &value);
+  if (err < 0) return err;
 
-static inline auto
-js_run_script(js_env_t *env, const js_string_t &source, js_handle_t &result) {
-  return js_run_script(env, nullptr, 0, 0, static_cast<js_value_t *>(source), static_cast<js_value_t **>(result));
+  if (value) result = T(value);
+  else result.reset();
+
+  return 0;
 }
 
 template <typename T>
 static inline auto
-js_create_reference(js_env_t *env, const T &value, js_persistent_t<T> &result) {
+js_is_reference_alive(js_env_t *env, const js_weak_t<T> &reference, bool &result) {
   int err;
 
-  js_ref_t *ref;
-  err = js_create_reference(env, static_cast<js_value_t *>(value), 1, &ref);
+  js_value_t *value;
+  err = js_get_reference_value(env, static_cast<js_ref_t *>(reference), &value);
   if (err < 0) return err;
 
-  result = js_persistent_t<T>(env, ref);
+  result = value != nullptr;
 
   return 0;
 }
 
 template <typename T>
 static inline auto
-js_get_reference_value(js_env_t *env, const js_persistent_t<T> &reference, T &result) {
+js_upgrade_reference(js_env_t *env, const js_weak_t<T> &reference, js_persistent_t<T> &result) {
   int err;
 
   js_value_t *value;
   err = js_get_reference_value(env, static_cast<js_ref_t *>(reference), &value);
   if (err < 0) return err;
 
-  result = T(value);
+  if (value == nullptr) {
+    result.reset();
+
+    return 0;
+  }
+
+  return js_create_reference(env, T(value), result);
+}
+
+template <js_string_literal_t... names>
+static inline int
+js_create_object_shape(js_env_t *env, js_object_shape_t<names...> &result) {
+  int err = 0;
+
+  std::array<js_persistent_t<js_string_t>, sizeof...(names)> keys;
+
+  size_t i = 0;
+
+  auto create = [&](const auto &name) {
+    js_string_t key;
+    err = js_create_property_key(env, name, key);
+    if (err < 0) return false;
+
+    err = js_create_reference(env, key, keys[i++]);
+    if (err < 0) return false;
+
+    return true;
+  };
+
+  (create(names) && ...);
+
+  if (err < 0) return err;
+
+  result = js_object_shape_t<names...>(std::move(keys));
 
   return 0;
 }
 
+template <js_type_options_t options = js_type_options_t(), js_string_literal_t... names, typename... T>
+static inline int
+js_create_object(js_env_t *env, const js_object_shape_t<names...> &shape, js_object_t &result, const T &...values) {
+  static_assert(sizeof...(T) == sizeof...(names), "Shape and value count must match");
+
+  int err;
+
+  js_property_descriptor_t descriptors[sizeof...(names)];
+
+  const auto &keys = shape.keys();
+
+  for (size_t i = 0; i < sizeof...(names); i++) {
+    auto &descriptor = descriptors[i];
+
+    descriptor.version = 0;
+    descriptor.data = nullptr;
+    descriptor.attributes = js_writable | js_enumerable | js_configurable;
+    descriptor.method = nullptr;
+    descriptor.getter = nullptr;
+    descriptor.setter = nullptr;
+
+    err = js_get_reference_value(env, static_cast<js_ref_t *>(keys[i]), &descriptor.name);
+    if (err < 0) return err;
+  }
+
+  try {
+    size_t i = 0;
+
+    ((descriptors[i++].value = js_marshall_untyped_value<options, T>(env, values)), ...);
+  } catch (int err) {
+    return err;
+  }
+
+  err = js_create_object(env, result);
+  if (err < 0) return err;
+
+  return js_define_properties(env, static_cast<js_value_t *>(result), descriptors, sizeof...(names));
+}
+
 template <typename T>
 static inline auto
 js_wrap(js_env_t *env, const js_object_t &object, T *data) {
@@ -5416,3 +8653,389 @@ static inline auto
 js_finish_teardown_callback(js_deferred_teardown_t *handle) {
   return js_finish_deferred_teardown_callback(handle);
 }
+
+struct js_file_reader_options_t {
+  size_t chunk_size = 65536;
+  size_t readahead = 4;
+};
+
+struct js_file_reader_t {
+  using callback_t = js_function_t<void, js_handle_t, js_handle_t>;
+
+  js_file_reader_t(const js_file_reader_t &) = delete;
+
+  void
+  operator=(const js_file_reader_t &) = delete;
+
+  static int
+  open(js_env_t *env, js_arraybuffer_pool_t &pool, const char *path, const callback_t &callback, js_file_reader_options_t options) {
+    int err;
+
+    if (options.chunk_size == 0 || options.chunk_size > UINT_MAX || options.readahead == 0) return UV_EINVAL;
+
+    auto reader = new js_file_reader_t(env, pool, options);
+
+    err = js_create_reference(env, callback, reader->callback_);
+
+    if (err < 0) {
+      reader->close();
+
+      return err;
+    }
+
+    err = js_add_teardown_callback<on_teardown>(env, reader, reader->teardown_);
+
+    if (err < 0) {
+      reader->close();
+
+      return err;
+    }
+
+    uv_loop_t *loop;
+    err = js_get_env_loop(env, &loop);
+    assert(err == 0);
+
+    reader->open_.data = reader;
+
+    err = uv_fs_open(loop, &reader->open_, path, UV_FS_O_RDONLY | UV_FS_O_SEQUENTIAL, 0, on_open);
+
+    if (err < 0) {
+      reader->end();
+
+      return err;
+    }
+
+    reader->pending_++;
+
+    return 0;
+  }
+
+private:
+  struct request_t {
+    uv_fs_t req;
+    js_file_reader_t *reader;
+    uint8_t *data;
+    uint64_t offset;
+    ssize_t result;
+    bool done;
+  };
+
+  js_env_t *env_;
+  js_arraybuffer_pool_t::state_t *pool_;
+  js_persistent_t<callback_t> callback_;
+  js_deferred_teardown_t *teardown_;
+  uv_fs_t open_;
+  uv_file file_;
+  size_t chunk_size_;
+  uint64_t offset_;
+  uint64_t position_;
+  std::vector<request_t> requests_;
+  size_t head_;
+  size_t pending_;
+  bool ended_;
+  bool closing_;
+
+  js_file_reader_t(js_env_t *env, js_arraybuffer_pool_t &pool, js_file_reader_options_t options)
+      : env_(env),
+        pool_(js_arraybuffer_pool_t::ref(pool.state_)),
+        callback_(),
+        teardown_(nullptr),
+        file_(-1),
+        chunk_size_(options.chunk_size),
+        offset_(0),
+        position_(0),
+        requests_(options.readahead),
+        head_(0),
+        pending_(0),
+        ended_(false),
+        closing_(false) {}
+
+  int
+  read(request_t &request) {
+    int err;
+
+    err = js_arraybuffer_pool_t::acquire(pool_, chunk_size_, request.data);
+    if (err < 0) return err;
+
+    uv_loop_t *loop;
+    err = js_get_env_loop(env_, &loop);
+    assert(err == 0);
+
+    auto buf = uv_buf_init(reinterpret_cast<char *>(request.data), static_cast<unsigned int>(chunk_size_));
+
+    request.reader = this;
+    request.offset = offset_;
+    request.done = false;
+
+    err = uv_fs_read(loop, &request.req, file_, &buf, 1, offset_, on_read);
+
+    if (err < 0) {
+      release(request);
+
+      return err;
+    }
+
+    offset_ += chunk_size_;
+
+    pending_++;
+
+    return 0;
+  }
+
+  void
+  release(request_t &request) {
+    if (request.data == nullptr) return;
+
+    js_arraybuffer_pool_t::release(request.data);
+
+    request.data = nullptr;
+  }
+
+  void
+  flush() {
+    int err;
+
+    if (closing_) {
+      for (auto &request : requests_) {
+        if (request.done) release(request);
+      }
+
+      if (pending_ == 0) close();
+
+      return;
+    }
+
+    js_handle_scope_t *scope;
+    err = js_open_handle_scope(env_, &scope);
+    assert(err == 0);
+
+    while (!ended_ && requests_[head_].done) {
+      auto &request = requests_[head_];
+
+      request.done = false;
+
+      head_ = (head_ + 1) % requests_.size();
+
+      if (request.result <= 0) {
+        release(request);
+
+        emit(request.result);
+
+        break;
+      }
+
+      if (request.offset != position_) {
+        release(request);
+
+        err = read(request);
+
+        if (err < 0) emit(err);
+
+        continue;
+      }
+
+      position_ += request.result;
+
+      if (size_t(request.result) < chunk_size_) offset_ = position_;
+
+      js_arraybuffer_t arraybuffer;
+      err = js_arraybuffer_pool_t::wrap(env_, request.data, size_t(request.result), arraybuffer);
+
+      if (err < 0) {
+        release(request);
+
+        emit(err);
+
+        break;
+      }
+
+      request.data = nullptr;
+
+      js_uint8array_t chunk;
+      err = js_create_typedarray(env_, size_t(request.result), arraybuffer, chunk);
+
+      if (err < 0) {
+        emit(err);
+
+        break;
+      }
+
+      emit(0, chunk);
+
+      if (ended_) break;
+
+      err = read(request);
+
+      if (err < 0) emit(err);
+    }
+
+    err = js_close_handle_scope(env_, scope);
+    assert(err == 0);
+
+    if (ended_) end();
+  }
+
+  void
+  emit(int status, const js_handle_t &chunk = js_handle_t()) {
+    int err;
+
+    js_value_t *error;
+
+    if (status < 0) {
+      js_value_t *code;
+      err = js_create_string_utf8(env_, reinterpret_cast<const utf8_t *>(uv_err_name(status)), -1, &code);
+      assert(err == 0);
+
+      js_value_t *message;
+      err = js_create_string_utf8(env_, reinterpret_cast<const utf8_t *>(uv_strerror(status)), -1, &message);
+      assert(err == 0);
+
+      err = js_create_error(env_, code, message, &error);
+      assert(err == 0);
+    } else {
+      err = js_get_null(env_, &error);
+      assert(err == 0);
+    }
+
+    js_value_t *value = static_cast<js_value_t *>(chunk);
+
+    if (value == nullptr) {
+      ended_ = true;
+
+      err = js_get_undefined(env_, &value);
+      assert(err == 0);
+    }
+
+    callback_t callback;
+    err = js_get_reference_value(env_, callback_, callback);
+    assert(err == 0);
+
+    js_call_function_with_checkpoint(env_, callback, js_handle_t(error), js_handle_t(value));
+  }
+
+  void
+  end() {
+    ended_ = true;
+
+    for (auto &request : requests_) {
+      if (request.done) release(request);
+    }
+
+    if (pending_ == 0) close();
+  }
+
+  void
+  close() {
+    int err;
+
+    if (file_ >= 0) {
+      uv_fs_t req;
+      uv_fs_close(nullptr, &req, file_, nullptr);
+      uv_fs_req_cleanup(&req);
+    }
+
+    callback_.reset();
+
+    js_arraybuffer_pool_t::unref(pool_);
+
+    if (teardown_) {
+      err = js_finish_teardown_callback(teardown_);
+      assert(err == 0);
+    }
+
+    delete this;
+  }
+
+  static void
+  on_open(uv_fs_t *req) {
+    int err;
+
+    auto reader = reinterpret_cast<js_file_reader_t *>(req->data);
+
+    auto status = int(req->result);
+
+    uv_fs_req_cleanup(req);
+
+    reader->pending_--;
+
+    if (status >= 0) reader->file_ = status;
+
+    if (reader->closing_) {
+      if (reader->pending_ == 0) reader->close();
+
+      return;
+    }
+
+    js_handle_scope_t *scope;
+    err = js_open_handle_scope(reader->env_, &scope);
+    assert(err == 0);
+
+    if (status < 0) {
+      reader->emit(status);
+    } else {
+      for (auto &request : reader->requests_) {
+        err = reader->read(request);
+
+        if (err < 0) {
+          reader->emit(err);
+
+          break;
+        }
+      }
+    }
+
+    err = js_close_handle_scope(reader->env_, scope);
+    assert(err == 0);
+
+    if (reader->ended_) reader->end();
+  }
+
+  static void
+  on_read(uv_fs_t *req) {
+    auto &request = *reinterpret_cast<request_t *>(req);
+
+    auto reader = request.reader;
+
+    request.result = req->result;
+    request.done = true;
+
+    uv_fs_req_cleanup(req);
+
+    reader->pending_--;
+
+    reader->flush();
+  }
+
+  static void
+  on_teardown(js_deferred_teardown_t *, js_file_reader_t *reader) {
+    reader->closing_ = true;
+    reader->ended_ = true;
+
+    for (auto &request : reader->requests_) {
+      if (request.done) reader->release(request);
+    }
+
+    if (reader->pending_ == 0) reader->close();
+  }
+};
+
+static inline int
+js_read_file(js_env_t *env, js_arraybuffer_pool_t &pool, const char *path, const js_file_reader_t::callback_t &callback, js_file_reader_options_t options = js_file_reader_options_t()) {
+  int err;
+
+  err = js_file_reader_t::open(env, pool, path, callback, options);
+
+  if (err < 0) {
+    err = js_throw_error(env, uv_err_name(err), uv_strerror(err));
+    assert(err == 0);
+
+    return js_pending_exception;
+  }
+
+  return 0;
+}
+
+#if defined(_WIN32)
+#pragma pop_macro("max")
+#pragma pop_macro("min")
+#endif
@@ -0,0 +1,64 @@
+#include <assert.h>
+#include <js.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_arraybuffer_pool_t pool;
+
+  auto size_class = js_arraybuffer_pool_t::size_class(20000);
+
+  uint8_t *data;
+  js_arraybuffer_t arraybuffer;
+  e = js_create_arraybuffer(env, pool, 20000, data, arraybuffer);
+  assert(e == 0);
+
+  assert(pool.misses(size_class) == 1);
+  assert(pool.hits(size_class) == 0);
+
+  size_t len;
+  e = js_get_arraybuffer_info(env, arraybuffer, data, len);
+  assert(e == 0);
+
+  assert(len == 20000);
+  assert(data[0] == 0);
+  assert(data[19999] == 0);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+
+  e = pool.acquire(30000, data);
+  assert(e == 0);
+
+  assert(pool.misses(size_class) == 1);
+  assert(pool.hits(size_class) == 1);
+
+  js_arraybuffer_pool_t::release(data);
+}
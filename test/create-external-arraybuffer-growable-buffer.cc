@@ -0,0 +1,83 @@
+#include <assert.h>
+#include <js.h>
+#include <string.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_growable_buffer_t oversized;
+
+  e = oversized.reserve(SIZE_MAX);
+  assert(e == UV_EINVAL);
+
+  js_growable_buffer_t buffer;
+
+  e = buffer.reserve(1024 * 1024);
+  assert(e == 0);
+
+  e = buffer.append("hello", 5);
+  assert(e == 0);
+
+  js_arraybuffer_t first;
+  e = js_create_external_arraybuffer(env, buffer, first);
+  assert(e == 0);
+
+  for (int i = 0; i < 4096; i++) {
+    e = buffer.append(" world", 6);
+    assert(e == 0);
+  }
+
+  assert(buffer.size() == 5 + 4096 * 6);
+
+  js_arraybuffer_t second;
+  e = js_create_external_arraybuffer(env, buffer, second);
+  assert(e == 0);
+
+  uint8_t *data;
+  size_t len;
+  e = js_get_arraybuffer_info(env, first, data, len);
+  assert(e == 0);
+
+  assert(len == 5);
+  assert(data == buffer.data());
+  assert(memcmp(data, "hello", 5) == 0);
+
+  e = js_get_arraybuffer_info(env, second, data, len);
+  assert(e == 0);
+
+  assert(len == buffer.size());
+  assert(data == buffer.data());
+  assert(memcmp(data + 5, " world", 6) == 0);
+
+  buffer.reset();
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,92 @@
+#include <assert.h>
+#include <js.h>
+#include <stdbool.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+void
+on_call(js_env_t *env) {}
+
+constexpr js_function_options_t options = [] {
+  js_function_options_t options;
+  options.cached = true;
+  return options;
+}();
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_function_t<void> a;
+  e = js_create_function<on_call, options>(env, "foo", a);
+  assert(e == 0);
+
+  js_function_t<void> b;
+  e = js_create_function<on_call, options>(env, "foo", b);
+  assert(e == 0);
+
+  bool equal;
+  e = js_strict_equals(env, static_cast<js_value_t *>(a), static_cast<js_value_t *>(b), &equal);
+  assert(e == 0);
+
+  assert(equal);
+
+  js_function_t<void> c;
+  e = js_create_function<on_call>(env, c);
+  assert(e == 0);
+
+  e = js_strict_equals(env, static_cast<js_value_t *>(a), static_cast<js_value_t *>(c), &equal);
+  assert(e == 0);
+
+  assert(!equal);
+
+  js_object_t object;
+  e = js_create_object(env, object);
+  assert(e == 0);
+
+  e = js_set_property<on_call, options>(env, object, "foo");
+  assert(e == 0);
+
+  js_handle_t d;
+  e = js_get_property(env, object, "foo", d);
+  assert(e == 0);
+
+  e = js_strict_equals(env, static_cast<js_value_t *>(a), static_cast<js_value_t *>(d), &equal);
+  assert(e == 0);
+
+  assert(equal);
+
+  e = js_set_property<on_call, options>(env, object, "bar");
+  assert(e == js_pending_exception);
+
+  js_value_t *error;
+  e = js_get_and_clear_last_exception(env, &error);
+  assert(e == 0);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
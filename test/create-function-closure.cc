@@ -0,0 +1,69 @@
+#include <assert.h>
+#include <js.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+struct connection_t {
+  int32_t sent;
+};
+
+int32_t
+on_send(js_env_t *, connection_t *connection, int32_t n) {
+  return connection->sent += n;
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  connection_t connection = {40};
+
+  js_function_t<int32_t, int32_t> send;
+  e = js_create_function<on_send>(env, &connection, send);
+  assert(e == 0);
+
+  int32_t result;
+  e = js_call_function(env, send, 2, result);
+  assert(e == 0);
+
+  assert(result == 42);
+  assert(connection.sent == 42);
+
+  int32_t calls = 0;
+
+  js_function_t<void, int32_t> add;
+  e = js_create_function(env, [&calls](int32_t n) { calls += n; }, add);
+  assert(e == 0);
+
+  e = js_call_function(env, add, 2);
+  assert(e == 0);
+
+  assert(calls == 2);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,78 @@
+#include <assert.h>
+#include <js.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+struct counter_t {
+  int32_t value;
+
+  void
+  increment(int32_t n) {
+    value += n;
+  }
+
+  int32_t
+  get(js_env_t *) const {
+    return value;
+  }
+};
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  counter_t counter = {40};
+
+  js_object_t object;
+  e = js_create_object(env, object);
+  assert(e == 0);
+
+  e = js_wrap(env, object, &counter);
+  assert(e == 0);
+
+  js_function_t<void, js_receiver_t, int32_t> increment;
+  e = js_create_function<&counter_t::increment>(env, increment);
+  assert(e == 0);
+
+  e = js_call_function(env, increment, js_receiver_t(object), 2);
+  assert(e == 0);
+
+  assert(counter.value == 42);
+
+  js_function_t<int32_t, js_receiver_t> get;
+  e = js_create_function<&counter_t::get>(env, get);
+  assert(e == 0);
+
+  int32_t result;
+  e = js_call_function(env, get, js_receiver_t(object), result);
+  assert(e == 0);
+
+  assert(result == 42);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
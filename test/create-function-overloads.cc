@@ -0,0 +1,99 @@
+#include <assert.h>
+#include <js.h>
+#include <string>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+int32_t
+on_call_string(js_env_t *, std::string s) {
+  assert(s == "hello");
+
+  return 1;
+}
+
+int32_t
+on_call_string_int32(js_env_t *, std::string s, int32_t n) {
+  assert(s == "hello");
+  assert(n == 42);
+
+  return 2;
+}
+
+int32_t
+on_call_uint8array(js_env_t *, js_uint8array_t) {
+  return 3;
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_handle_t fn;
+  e = js_create_function<on_call_string, on_call_string_int32, on_call_uint8array>(env, fn);
+  assert(e == 0);
+
+  int32_t result;
+
+  e = js_call_function(env, js_function_t<int32_t, std::string>(static_cast<js_value_t *>(fn)), std::string("hello"), result);
+  assert(e == 0);
+
+  assert(result == 1);
+
+  e = js_call_function(env, js_function_t<int32_t, std::string, int32_t>(static_cast<js_value_t *>(fn)), std::string("hello"), 42, result);
+  assert(e == 0);
+
+  assert(result == 2);
+
+  js_uint8array_t typedarray;
+  e = js_create_typedarray(env, 4, typedarray);
+  assert(e == 0);
+
+  e = js_call_function(env, js_function_t<int32_t, js_uint8array_t>(static_cast<js_value_t *>(fn)), typedarray, result);
+  assert(e == 0);
+
+  assert(result == 3);
+
+  e = js_call_function(env, js_function_t<int32_t, js_uint8array_t, int32_t>(static_cast<js_value_t *>(fn)), typedarray, 42, result);
+  assert(e == 0);
+
+  assert(result == 3);
+
+  e = js_call_function(env, js_function_t<int32_t, std::string, int32_t, int32_t>(static_cast<js_value_t *>(fn)), std::string("hello"), 42, 7, result);
+  assert(e == 0);
+
+  assert(result == 2);
+
+  e = js_call_function(env, js_function_t<int32_t, int32_t>(static_cast<js_value_t *>(fn)), 42, result);
+  assert(e == js_pending_exception);
+
+  js_value_t *error;
+  e = js_get_and_clear_last_exception(env, &error);
+  assert(e == 0);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,74 @@
+#include <assert.h>
+#include <js.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+js_growable_buffer_t
+on_call(js_env_t *) {
+  int e;
+
+  js_growable_buffer_t buffer;
+
+  for (int i = 0; i < 3; i++) {
+    uint8_t *data;
+    e = buffer.grow(4, data);
+    assert(e == 0);
+
+    data[0] = 'a' + i;
+    data[1] = 'b' + i;
+    data[2] = 'c' + i;
+    data[3] = 'd' + i;
+  }
+
+  return buffer;
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_function_t<js_arraybuffer_t> fn;
+  e = js_create_function<on_call>(env, fn);
+  assert(e == 0);
+
+  js_arraybuffer_t result;
+  e = js_call_function(env, fn, result);
+  assert(e == 0);
+
+  uint8_t *data;
+  size_t len;
+  e = js_get_arraybuffer_info(env, result, data, len);
+  assert(e == 0);
+
+  assert(len == 12);
+  assert(data[0] == 'a');
+  assert(data[4] == 'b');
+  assert(data[11] == 'f');
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,79 @@
+#include <assert.h>
+#include <js.h>
+#include <stdbool.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+struct foo {
+  int value;
+};
+
+template <>
+constexpr bool js_preserve_identity<foo> = true;
+
+foo value = {42};
+
+foo *
+on_call(js_env_t *env) {
+  return &value;
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_function_t<foo *> fn;
+  e = js_create_function<on_call>(env, fn);
+  assert(e == 0);
+
+  js_value_t *global;
+  e = js_get_global(env, &global);
+  assert(e == 0);
+
+  js_value_t *a;
+  e = js_call_function(env, global, static_cast<js_value_t *>(fn), 0, NULL, &a);
+  assert(e == 0);
+
+  js_value_t *b;
+  e = js_call_function(env, global, static_cast<js_value_t *>(fn), 0, NULL, &b);
+  assert(e == 0);
+
+  bool equal;
+  e = js_strict_equals(env, a, b, &equal);
+  assert(e == 0);
+
+  assert(equal);
+
+  foo *result;
+  e = js_call_function(env, fn, result);
+  assert(e == 0);
+
+  assert(result == &value);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,115 @@
+#include <assert.h>
+#include <deque>
+#include <js.h>
+#include <ranges>
+#include <span>
+#include <stdint.h>
+#include <uv.h>
+#include <vector>
+
+#include "../include/jstl.h"
+
+template <>
+constexpr bool js_is_array_range<std::deque<int32_t>> = true;
+
+auto
+on_call_view(js_env_t *env) {
+  return std::views::iota(0, 100) | std::views::filter([](int32_t n) { return n % 2 == 0; }) | std::views::transform([](int32_t n) { return n * n; });
+}
+
+js_generator_t<int32_t>
+on_call_generator(js_env_t *env) {
+  for (int32_t i = 0; i < 100; i++) co_yield i;
+}
+
+std::deque<int32_t>
+on_call_deque(js_env_t *env) {
+  return {1, 2, 3};
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  {
+    js_function_t<decltype(on_call_view(nullptr))> fn;
+    e = js_create_function<on_call_view>(env, fn);
+    assert(e == 0);
+
+    std::vector<int32_t> result;
+    e = js_call_function(env, js_function_t<std::vector<int32_t>>(static_cast<js_value_t *>(fn)), result);
+    assert(e == 0);
+
+    assert(result.size() == 50);
+
+    for (int32_t i = 0; i < 50; i++) assert(result[i] == 4 * i * i);
+  }
+
+  {
+    js_function_t<js_generator_t<int32_t>> fn;
+    e = js_create_function<on_call_generator>(env, fn);
+    assert(e == 0);
+
+    std::vector<int32_t> result;
+    e = js_call_function(env, js_function_t<std::vector<int32_t>>(static_cast<js_value_t *>(fn)), result);
+    assert(e == 0);
+
+    assert(result.size() == 100);
+
+    for (int32_t i = 0; i < 100; i++) assert(result[i] == i);
+  }
+
+  {
+    js_function_t<std::deque<int32_t>> fn;
+    e = js_create_function<on_call_deque>(env, fn);
+    assert(e == 0);
+
+    std::vector<int32_t> result;
+    e = js_call_function(env, js_function_t<std::vector<int32_t>>(static_cast<js_value_t *>(fn)), result);
+    assert(e == 0);
+
+    assert(result.size() == 3);
+
+    for (int32_t i = 0; i < 3; i++) assert(result[i] == i + 1);
+  }
+
+  {
+    js_typedarray_t<int32_t> typedarray;
+    e = js_create_typedarray(env, std::views::iota(0, 100) | std::views::transform([](int32_t n) { return n * 2; }), typedarray);
+    assert(e == 0);
+
+    std::span<int32_t> view;
+    e = js_get_typedarray_info(env, typedarray, view);
+    assert(e == 0);
+
+    assert(view.size() == 100);
+
+    for (int32_t i = 0; i < 100; i++) assert(view[i] == i * 2);
+  }
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,63 @@
+#include <algorithm>
+#include <assert.h>
+#include <js.h>
+#include <stdint.h>
+#include <uv.h>
+#include <vector>
+
+#include "../include/jstl.h"
+
+void
+on_call(js_env_t *env, js_array_view_t<int32_t> view) {
+  assert(view.size() == 1000);
+
+  auto it = std::find_if(view.begin(), view.end(), [](int32_t n) { return n == 100; });
+
+  assert(it != view.end());
+  assert(it.index() == 100);
+
+  assert(view[999] == 999);
+  assert(view[0] == 0);
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_function_t<void, js_array_view_t<int32_t>> fn;
+  e = js_create_function<on_call>(env, fn);
+  assert(e == 0);
+
+  std::vector<int32_t> array(1000);
+
+  for (int32_t i = 0; i < 1000; i++) array[i] = i;
+
+  e = js_call_function(env, js_function_t<void, std::vector<int32_t>>(static_cast<js_value_t *>(fn)), array);
+  assert(e == 0);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
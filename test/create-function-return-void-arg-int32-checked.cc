@@ -0,0 +1,86 @@
+#include <assert.h>
+#include <js.h>
+#include <stdint.h>
+#include <string>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+constexpr js_function_options_t options = [] {
+  js_function_options_t options;
+  options.checked = true;
+  return options;
+}();
+
+int calls = 0;
+
+void
+on_call(js_env_t *env, int32_t n) {
+  assert(n == 42);
+
+  calls++;
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_function_t<void, int32_t> fn;
+  e = js_create_function<on_call, options>(env, fn);
+  assert(e == 0);
+
+  js_function_t<void, double> as_double(static_cast<js_value_t *>(fn));
+
+  e = js_call_function(env, as_double, 42.0);
+  assert(e == 0);
+
+  js_value_t *error;
+
+  e = js_call_function(env, as_double, 42.5);
+  assert(e == js_pending_exception);
+
+  e = js_get_and_clear_last_exception(env, &error);
+  assert(e == 0);
+
+  e = js_call_function(env, as_double, 2147483648.0);
+  assert(e == js_pending_exception);
+
+  e = js_get_and_clear_last_exception(env, &error);
+  assert(e == 0);
+
+  js_function_t<void, std::string> as_string(static_cast<js_value_t *>(fn));
+
+  e = js_call_function(env, as_string, std::string("42"));
+  assert(e == js_pending_exception);
+
+  e = js_get_and_clear_last_exception(env, &error);
+  assert(e == 0);
+
+  assert(calls == 1);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
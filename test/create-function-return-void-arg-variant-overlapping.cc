@@ -0,0 +1,97 @@
+#include <assert.h>
+#include <js.h>
+#include <stdint.h>
+#include <uv.h>
+#include <variant>
+
+#include "../include/jstl.h"
+
+using variant_t = std::variant<js_uint8array_t, js_object_t>;
+
+using numeric_variant_t = std::variant<int32_t, double>;
+
+size_t alternative = size_t(-1);
+
+void
+on_call(js_env_t *env, variant_t value) {
+  alternative = value.index();
+}
+
+void
+on_numeric_call(js_env_t *env, numeric_variant_t value) {
+  alternative = value.index();
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_function_t<void, variant_t> fn;
+  e = js_create_function<on_call>(env, fn);
+  assert(e == 0);
+
+  js_uint8array_t typedarray;
+  e = js_create_typedarray(env, 4, typedarray);
+  assert(e == 0);
+
+  e = js_call_function(env, fn, variant_t(typedarray));
+  assert(e == 0);
+
+  assert(alternative == 0);
+
+  js_object_t object;
+  e = js_create_object(env, object);
+  assert(e == 0);
+
+  e = js_call_function(env, fn, variant_t(object));
+  assert(e == 0);
+
+  assert(alternative == 1);
+
+  js_function_t<void, numeric_variant_t> numeric_fn;
+  e = js_create_function<on_numeric_call>(env, numeric_fn);
+  assert(e == 0);
+
+  js_function_t<void, double> as_double(static_cast<js_value_t *>(numeric_fn));
+
+  e = js_call_function(env, as_double, 2.0);
+  assert(e == 0);
+
+  assert(alternative == 0);
+
+  e = js_call_function(env, as_double, 1.5);
+  assert(e == 0);
+
+  assert(alternative == 1);
+
+  e = js_call_function(env, as_double, 4294967296.0);
+  assert(e == 0);
+
+  assert(alternative == 1);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
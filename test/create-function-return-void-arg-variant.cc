@@ -0,0 +1,87 @@
+#include <assert.h>
+#include <js.h>
+#include <stdint.h>
+#include <string>
+#include <uv.h>
+#include <variant>
+
+#include "../include/jstl.h"
+
+using variant_t = std::variant<int32_t, std::string, js_uint8array_t>;
+
+size_t alternative = size_t(-1);
+
+void
+on_call(js_env_t *env, variant_t value) {
+  alternative = value.index();
+
+  switch (alternative) {
+  case 0:
+    assert(std::get<0>(value) == 42);
+    break;
+  case 1:
+    assert(std::get<1>(value) == "hello");
+    break;
+  }
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_function_t<void, variant_t> fn;
+  e = js_create_function<on_call>(env, fn);
+  assert(e == 0);
+
+  e = js_call_function(env, fn, variant_t(int32_t(42)));
+  assert(e == 0);
+
+  assert(alternative == 0);
+
+  e = js_call_function(env, fn, variant_t(std::string("hello")));
+  assert(e == 0);
+
+  assert(alternative == 1);
+
+  js_uint8array_t typedarray;
+  e = js_create_typedarray(env, 4, typedarray);
+  assert(e == 0);
+
+  e = js_call_function(env, fn, variant_t(typedarray));
+  assert(e == 0);
+
+  assert(alternative == 2);
+
+  e = js_call_function(env, js_function_t<void, bool>(static_cast<js_value_t *>(fn)), true);
+  assert(e == js_pending_exception);
+
+  js_value_t *error;
+  e = js_get_and_clear_last_exception(env, &error);
+  assert(e == 0);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,92 @@
+#include <assert.h>
+#include <js.h>
+#include <stdio.h>
+#include <string.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  FILE *file = fopen("LICENSE", "rb");
+  assert(file);
+
+  char expected[100];
+  e = fseek(file, 5000, SEEK_SET);
+  assert(e == 0);
+
+  size_t read = fread(expected, 1, sizeof(expected), file);
+  assert(read == sizeof(expected));
+
+  fseek(file, 0, SEEK_END);
+
+  long size = ftell(file);
+
+  fclose(file);
+
+  js_arraybuffer_t arraybuffer;
+  e = js_create_mapped_arraybuffer(env, "LICENSE", 5000, sizeof(expected), js_mapped_file_sequential, arraybuffer);
+  assert(e == 0);
+
+  uint8_t *data;
+  size_t len;
+  e = js_get_arraybuffer_info(env, arraybuffer, data, len);
+  assert(e == 0);
+
+  assert(len == sizeof(expected));
+  assert(memcmp(data, expected, len) == 0);
+
+  e = js_create_mapped_arraybuffer(env, "LICENSE", arraybuffer);
+  assert(e == 0);
+
+  e = js_get_arraybuffer_info(env, arraybuffer, data, len);
+  assert(e == 0);
+
+  assert(len == size_t(size));
+  assert(memcmp(data + 5000, expected, sizeof(expected)) == 0);
+
+  data[0] = 'x';
+
+  e = js_create_mapped_arraybuffer(env, "LICENSE", size, size_t(-1), arraybuffer);
+  assert(e == 0);
+
+  e = js_get_arraybuffer_info(env, arraybuffer, data, len);
+  assert(e == 0);
+
+  assert(len == 0);
+
+  e = js_create_mapped_arraybuffer(env, "missing", arraybuffer);
+  assert(e == js_pending_exception);
+
+  js_value_t *error;
+  e = js_get_and_clear_last_exception(env, &error);
+  assert(e == 0);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,65 @@
+#include <assert.h>
+#include <js.h>
+#include <stdint.h>
+#include <string>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_object_shape_t<"id", "name"> shape;
+  assert(shape.empty());
+
+  e = js_create_object_shape(env, shape);
+  assert(e == 0);
+  assert(!shape.empty());
+
+  for (int32_t i = 0; i < 10; i++) {
+    js_object_t object;
+    e = js_create_object(env, shape, object, i, std::string("hello"));
+    assert(e == 0);
+
+    int32_t id;
+    e = js_get_property(env, object, "id", id);
+    assert(e == 0);
+
+    assert(id == i);
+
+    std::string name;
+    e = js_get_property(env, object, "name", name);
+    assert(e == 0);
+
+    assert(name == "hello");
+  }
+
+  shape.reset();
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
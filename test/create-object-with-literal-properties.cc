@@ -0,0 +1,60 @@
+#include <assert.h>
+#include <js.h>
+#include <stdint.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  for (int32_t i = 0; i < 2; i++) {
+    js_object_t object;
+    e = js_create_object(
+      env,
+      object,
+      js_literal_property_t<"foo", int32_t>(i),
+      js_literal_property_t<"bar", bool>(true)
+    );
+    assert(e == 0);
+
+    int32_t foo;
+    e = js_get_property(env, object, "foo", foo);
+    assert(e == 0);
+
+    assert(foo == i);
+
+    bool bar;
+    e = js_get_property(env, object, "bar", bar);
+    assert(e == 0);
+
+    assert(bar);
+  }
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
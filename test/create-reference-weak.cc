@@ -0,0 +1,82 @@
+#include <assert.h>
+#include <js.h>
+#include <optional>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_object_t object;
+  e = js_create_object(env, object);
+  assert(e == 0);
+
+  {
+    js_weak_t<js_object_t> reference;
+    e = js_create_reference(env, object, reference);
+    assert(e == 0);
+
+    bool alive;
+    e = js_is_reference_alive(env, reference, alive);
+    assert(e == 0);
+
+    assert(alive);
+
+    std::optional<js_object_t> value;
+    e = js_get_reference_value(env, reference, value);
+    assert(e == 0);
+
+    assert(value);
+
+    js_persistent_t<js_object_t> strong;
+    e = js_upgrade_reference(env, reference, strong);
+    assert(e == 0);
+
+    assert(!strong.empty());
+  }
+
+  {
+    js_weak_cache_t<int, js_object_t> cache;
+    e = cache.set(env, 42, object);
+    assert(e == 0);
+
+    std::optional<js_object_t> value;
+    e = cache.get(env, 42, value);
+    assert(e == 0);
+
+    assert(value);
+
+    e = cache.get(env, 43, value);
+    assert(e == 0);
+
+    assert(!value);
+  }
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
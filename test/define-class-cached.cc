@@ -0,0 +1,71 @@
+#include <assert.h>
+#include <js.h>
+#include <stdbool.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+struct counter_t {
+  int32_t value;
+};
+
+counter_t *
+on_construct(js_env_t *, int32_t start) {
+  return new counter_t{start};
+}
+
+int32_t
+on_get_value(js_env_t *, counter_t *counter) {
+  return counter->value;
+}
+
+constexpr js_function_options_t options = [] {
+  js_function_options_t options;
+  options.cached = true;
+  return options;
+}();
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_object_t a;
+  e = js_define_class<on_construct, options>(env, "Counter", a, js_property_t("value", js_accessor_t<on_get_value>()));
+  assert(e == 0);
+
+  js_object_t b;
+  e = js_define_class<on_construct, options>(env, "Counter", b, js_property_t("value", js_accessor_t<on_get_value>()));
+  assert(e == 0);
+
+  bool equal;
+  e = js_strict_equals(env, static_cast<js_value_t *>(a), static_cast<js_value_t *>(b), &equal);
+  assert(e == 0);
+
+  assert(equal);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
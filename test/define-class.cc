@@ -0,0 +1,136 @@
+#include <assert.h>
+#include <js.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+struct counter_t {
+  int32_t value;
+};
+
+counter_t *
+on_construct(js_env_t *, int32_t start) {
+  return new counter_t{start};
+}
+
+int32_t
+on_increment(js_env_t *, counter_t *counter, int32_t n) {
+  return counter->value += n;
+}
+
+int32_t
+on_get_value(js_env_t *, counter_t *counter) {
+  return counter->value;
+}
+
+void
+on_set_value(js_env_t *, counter_t *counter, int32_t value) {
+  counter->value = value;
+}
+
+int32_t
+on_max(js_env_t *, int32_t a, int32_t b) {
+  return a > b ? a : b;
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_object_t counter_class;
+  e = js_define_class<on_construct>(
+    env,
+    "Counter",
+    counter_class,
+    js_property_t("increment", js_method_t<on_increment>()),
+    js_property_t("value", js_accessor_t<on_get_value, on_set_value>()),
+    js_property_t("max", js_static_method_t<on_max>())
+  );
+  assert(e == 0);
+
+  js_value_t *argv[1];
+  e = js_create_int32(env, 5, &argv[0]);
+  assert(e == 0);
+
+  js_value_t *instance;
+  e = js_new_instance(env, static_cast<js_value_t *>(counter_class), 1, argv, &instance);
+  assert(e == 0);
+
+  js_object_t counter(instance);
+
+  js_function_t<int32_t, js_receiver_t, int32_t> increment;
+  e = js_get_property(env, counter, "increment", increment);
+  assert(e == 0);
+
+  int32_t result;
+  e = js_call_function(env, increment, js_receiver_t(instance), 2, result);
+  assert(e == 0);
+
+  assert(result == 7);
+
+  js_value_t *error;
+
+  js_object_t other;
+  e = js_create_object(env, other);
+  assert(e == 0);
+
+  e = js_call_function(env, increment, js_receiver_t(static_cast<js_value_t *>(other)), 2, result);
+  assert(e == js_pending_exception);
+
+  e = js_get_and_clear_last_exception(env, &error);
+  assert(e == 0);
+
+  e = js_new_instance(env, static_cast<js_value_t *>(counter_class), 0, nullptr, &instance);
+  assert(e == js_pending_exception);
+
+  e = js_get_and_clear_last_exception(env, &error);
+  assert(e == 0);
+
+  e = js_get_property(env, counter, "value", result);
+  assert(e == 0);
+
+  assert(result == 7);
+
+  e = js_set_property(env, counter, "value", int32_t(1));
+  assert(e == 0);
+
+  e = js_get_property(env, counter, "value", result);
+  assert(e == 0);
+
+  assert(result == 1);
+
+  js_function_t<int32_t, int32_t, int32_t> max;
+  e = js_get_property(env, counter_class, "max", max);
+  assert(e == 0);
+
+  e = js_call_function(env, max, 3, 4, result);
+  assert(e == 0);
+
+  assert(result == 4);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
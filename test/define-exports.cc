@@ -0,0 +1,77 @@
+#include <assert.h>
+#include <js.h>
+#include <stdint.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+int32_t
+on_foo(js_env_t *env) {
+  return 42;
+}
+
+int32_t
+on_bar(js_env_t *env) {
+  return 43;
+}
+
+using exports_t = js_exports_t<
+  js_export_t<"foo", on_foo>,
+  js_export_t<"bar", on_bar>>;
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_object_t exports;
+  e = js_create_object(env, exports);
+  assert(e == 0);
+
+  e = exports_t::define(env, exports);
+  assert(e == 0);
+
+  js_handle_t foo;
+  e = js_get_property(env, exports, "foo", foo);
+  assert(e == 0);
+
+  int32_t result;
+  e = js_call_function(env, js_function_t<int32_t>(static_cast<js_value_t *>(foo)), result);
+  assert(e == 0);
+
+  assert(result == 42);
+
+  js_handle_t bar;
+  e = js_get_property(env, exports, "bar", bar);
+  assert(e == 0);
+
+  e = js_call_function(env, js_function_t<int32_t>(static_cast<js_value_t *>(bar)), result);
+  assert(e == 0);
+
+  assert(result == 43);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
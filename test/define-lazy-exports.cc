@@ -0,0 +1,87 @@
+#include <assert.h>
+#include <js.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+int calls = 0;
+
+int32_t
+on_foo(js_env_t *env) {
+  calls++;
+
+  return 42;
+}
+
+void
+on_bar(js_env_t *env) {}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_object_t exports;
+  e = js_create_object(env, exports);
+  assert(e == 0);
+
+  e = js_define_lazy_exports<js_export_t<"foo", on_foo>, js_export_t<"bar", on_bar>>(env, exports);
+  assert(e == 0);
+
+  js_handle_t a;
+  e = js_get_property(env, exports, "foo", a);
+  assert(e == 0);
+
+  js_handle_t b;
+  e = js_get_property(env, exports, "foo", b);
+  assert(e == 0);
+
+  bool equal;
+  e = js_strict_equals(env, static_cast<js_value_t *>(a), static_cast<js_value_t *>(b), &equal);
+  assert(e == 0);
+
+  assert(equal);
+
+  int32_t result;
+  e = js_call_function(env, js_function_t<int32_t>(static_cast<js_value_t *>(a)), result);
+  assert(e == 0);
+
+  assert(result == 42);
+  assert(calls == 1);
+
+  e = js_set_property(env, exports, "bar", int32_t(1));
+  assert(e == 0);
+
+  int32_t bar;
+  e = js_get_property(env, exports, "bar", bar);
+  assert(e == 0);
+
+  assert(bar == 1);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,58 @@
+#include <assert.h>
+#include <js.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+int constructed = 0;
+int destroyed = 0;
+
+struct counter {
+  int value = 0;
+
+  counter(js_env_t *env) {
+    constructed++;
+  }
+
+  ~counter() {
+    destroyed++;
+  }
+};
+
+js_env_local_t<counter> local;
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  assert(local.find(env) == nullptr);
+
+  local.get(env).value++;
+  local.get(env).value++;
+
+  assert(constructed == 1);
+
+  assert(local.find(env) != nullptr);
+  assert(local.find(env)->value == 2);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  assert(destroyed == 1);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,78 @@
+#include <assert.h>
+#include <js.h>
+#include <stdint.h>
+#include <uv.h>
+#include <vector>
+
+#include "../include/jstl.h"
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  const uint32_t len = 10000;
+
+  std::vector<int32_t> values(len);
+
+  for (uint32_t i = 0; i < len; i++) values[i] = int32_t(i);
+
+  js_array_t array;
+  e = js_create_array(env, len, array);
+  assert(e == 0);
+
+  e = js_set_array_elements(env, array, values);
+  assert(e == 0);
+
+  int64_t sum = 0;
+  uint32_t count = 0;
+
+  e = js_for_each_element<int32_t, 128>(env, array, [&](int32_t n) {
+    assert(n == int32_t(count));
+
+    sum += n;
+    count++;
+  });
+  assert(e == 0);
+
+  assert(count == len);
+  assert(sum == int64_t(len) * (len - 1) / 2);
+
+  count = 0;
+
+  e = js_for_each_element<int32_t>(env, array, [&](int32_t n) {
+    if (n == 42) return -1;
+
+    count++;
+
+    return 0;
+  });
+  assert(e == -1);
+
+  assert(count == 42);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,82 @@
+#include <assert.h>
+#include <js.h>
+#include <stdint.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  const size_t len = 100000;
+
+  js_array_t array;
+
+  {
+    js_escapable_scope_t escapable(env);
+
+    js_array_t unescaped;
+    e = js_create_array(env, len, unescaped);
+    assert(e == 0);
+
+    e = js_for_each_scoped<256>(env, len, [&](size_t i) {
+      int err;
+
+      js_value_t *value;
+      err = js_create_int32(env, int32_t(i), &value);
+      if (err < 0) return err;
+
+      return js_set_element(env, static_cast<js_value_t *>(unescaped), uint32_t(i), value);
+    });
+    assert(e == 0);
+
+    e = escapable.escape(unescaped, array);
+    assert(e == 0);
+  }
+
+  int64_t sum = 0;
+
+  e = js_for_each_scoped(env, len, [&](size_t i) {
+    int err;
+
+    js_value_t *value;
+    err = js_get_element(env, static_cast<js_value_t *>(array), uint32_t(i), &value);
+    assert(err == 0);
+
+    int32_t n;
+    err = js_get_value_int32(env, value, &n);
+    assert(err == 0);
+
+    sum += n;
+  });
+  assert(e == 0);
+
+  assert(sum == int64_t(len) * (len - 1) / 2);
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,97 @@
+#include <assert.h>
+#include <js.h>
+#include <stdint.h>
+#include <string>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_object_t object;
+  e = js_create_object(env, object);
+  assert(e == 0);
+
+  e = js_set_property(env, object, "port", int32_t(8080));
+  assert(e == 0);
+
+  e = js_set_property(env, object, "host", std::string("localhost"));
+  assert(e == 0);
+
+  e = js_set_property(env, object, "secure", true);
+  assert(e == 0);
+
+  {
+    int32_t port;
+    std::string host;
+    bool secure;
+    e = js_get_properties<"port", "host", "secure">(env, object, port, host, secure);
+    assert(e == 0);
+
+    assert(port == 8080);
+    assert(host == "localhost");
+    assert(secure);
+  }
+
+  {
+    constexpr js_type_options_t options = [] {
+      js_type_options_t options;
+      options.checked = true;
+      return options;
+    }();
+
+    int32_t port, host;
+    e = js_get_properties<options, "port", "host">(env, object, port, host);
+    assert(e == js_pending_exception);
+
+    js_value_t *error;
+    e = js_get_and_clear_last_exception(env, &error);
+    assert(e == 0);
+
+    assert(port == 8080);
+  }
+
+  {
+    js_object_shape_t<"port", "host", "secure"> shape;
+    e = js_create_object_shape(env, shape);
+    assert(e == 0);
+
+    int32_t port;
+    std::string host;
+    bool secure;
+    e = js_get_properties(env, object, shape, port, host, secure);
+    assert(e == 0);
+
+    assert(port == 8080);
+    assert(host == "localhost");
+    assert(secure);
+  }
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
@@ -0,0 +1,101 @@
+#include <assert.h>
+#include <js.h>
+#include <stdio.h>
+#include <uv.h>
+
+#include "../include/jstl.h"
+
+static size_t bytes_read = 0;
+static int chunks = 0;
+static bool ended = false;
+
+void
+on_chunk(js_env_t *env, js_handle_t error, js_handle_t chunk) {
+  int e;
+
+  assert(!ended);
+
+  bool is_null;
+  e = js_is_null(env, static_cast<js_value_t *>(error), &is_null);
+  assert(e == 0);
+
+  assert(is_null);
+
+  bool is_undefined;
+  e = js_is_undefined(env, static_cast<js_value_t *>(chunk), &is_undefined);
+  assert(e == 0);
+
+  if (is_undefined) {
+    ended = true;
+
+    return;
+  }
+
+  uint8_t *data;
+  size_t len;
+  e = js_get_typedarray_info(env, js_uint8array_t(static_cast<js_value_t *>(chunk)), data, len);
+  assert(e == 0);
+
+  assert(len <= 4096);
+
+  bytes_read += len;
+  chunks++;
+}
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  FILE *file = fopen("LICENSE", "rb");
+  assert(file);
+
+  fseek(file, 0, SEEK_END);
+
+  size_t size = ftell(file);
+
+  fclose(file);
+
+  js_function_t<void, js_handle_t, js_handle_t> fn;
+  e = js_create_function<on_chunk>(env, fn);
+  assert(e == 0);
+
+  {
+    js_arraybuffer_pool_t pool;
+
+    e = js_read_file(env, pool, "LICENSE", fn, {.chunk_size = 4096, .readahead = 2});
+    assert(e == 0);
+  }
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+
+  assert(ended);
+  assert(bytes_read == size);
+  assert(chunks == int(size + 4095) / 4096);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}
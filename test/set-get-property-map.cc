@@ -0,0 +1,80 @@
+#include <assert.h>
+#include <js.h>
+#include <map>
+#include <stdint.h>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <uv.h>
+#include <vector>
+
+#include "../include/jstl.h"
+
+int
+main() {
+  int e;
+
+  uv_loop_t *loop = uv_default_loop();
+
+  js_platform_t *platform;
+  e = js_create_platform(loop, NULL, &platform);
+  assert(e == 0);
+
+  js_env_t *env;
+  e = js_create_env(loop, platform, NULL, &env);
+  assert(e == 0);
+
+  js_handle_scope_t *scope;
+  e = js_open_handle_scope(env, &scope);
+  assert(e == 0);
+
+  js_object_t object;
+  e = js_create_object(env, object);
+  assert(e == 0);
+
+  std::map<std::string, int32_t> map = {{"foo", 1}, {"bar", 2}, {"baz", 3}};
+
+  e = js_set_property(env, object, "map", map);
+  assert(e == 0);
+
+  {
+    std::map<std::string, int32_t> value;
+    e = js_get_property(env, object, "map", value);
+    assert(e == 0);
+
+    assert(value == map);
+  }
+
+  {
+    std::unordered_map<std::string, int32_t> value;
+    e = js_get_property(env, object, "map", value);
+    assert(e == 0);
+
+    assert(value.size() == 3);
+    assert(value["foo"] == 1);
+    assert(value["bar"] == 2);
+    assert(value["baz"] == 3);
+  }
+
+  {
+    std::vector<std::pair<std::string, int32_t>> value;
+    e = js_get_property(env, object, "map", value);
+    assert(e == 0);
+
+    std::vector<std::pair<std::string, int32_t>> expected = {{"bar", 2}, {"baz", 3}, {"foo", 1}};
+
+    assert(value == expected);
+  }
+
+  e = js_close_handle_scope(env, scope);
+  assert(e == 0);
+
+  e = js_destroy_env(env);
+  assert(e == 0);
+
+  e = js_destroy_platform(platform);
+  assert(e == 0);
+
+  e = uv_run(loop, UV_RUN_DEFAULT);
+  assert(e == 0);
+}